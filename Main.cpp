@@ -12,6 +12,8 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include "include/Base.h"
 #include "include/Pack.h"
@@ -26,6 +28,7 @@
 #include "include/Solver/BotBestPushesS/BotBestPushesS.h"
 #include "include/Solver/BotGoodPushesS/BotGoodPushesS.h"
 #include "include/Solver/BotIDA/BotIDA.h"
+#include "include/Solver/BotHDA/BotHDA.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -34,6 +37,61 @@ extern "C"
 
 int main(int argc, char **argv)
 {
+	/* SOLVEUR : options en premiers paramètres, les suivants sont ceux du jeu
+	 *   -hda n    : A* parallèle avec n threads (IDA* sinon)
+	 *   -growth p : IDA*, chaque itération vise p% des noeuds de la
+	 *               précédente (100 ou moins : plus petit f(x) rejeté)
+	 *   -fringe   : IDA*, chaque itération reprend les noeuds rejetés par la
+	 *               précédente (fringe search)
+	 *   -ida n    : IDA*, chaque itération est cherchée par n threads (vol
+	 *               de tâches, pas avec -fringe) */
+	bool hdaSolver = false;
+	int threadNumber = 1;
+	int thresholdGrowth = BotIDA::THRESHOLD_GROWTH;
+	bool fringeSearch = false;
+	int idaThreadNumber = 1;
+	bool option = true;
+	while(option && argc >= 2)
+	{
+		option = false;
+		int optionLength = 2;
+		if(strcmp(argv[1], "-fringe") == 0)
+		{
+			fringeSearch = true;
+			optionLength = 1;
+			option = true;
+		}
+		else if(argc < 3)
+			break;
+		else if(strcmp(argv[1], "-hda") == 0)
+		{
+			hdaSolver = true;
+			threadNumber = atoi(argv[2]);
+			if(threadNumber < 1)
+				threadNumber = 1;
+			option = true;
+		}
+		else if(strcmp(argv[1], "-ida") == 0)
+		{
+			idaThreadNumber = atoi(argv[2]);
+			if(idaThreadNumber < 1)
+				idaThreadNumber = 1;
+			option = true;
+		}
+		else if(strcmp(argv[1], "-growth") == 0)
+		{
+			thresholdGrowth = atoi(argv[2]);
+			option = true;
+		}
+
+		if(option)
+		{
+			argv[optionLength] = argv[0];
+			argv += optionLength;
+			argc -= optionLength;
+		}
+	}
+
 	/* BASE (init) */
 	Base* base = new Base(argc, argv);
 
@@ -43,6 +101,19 @@ int main(int argc, char **argv)
 	/* RESOLUTION */
 	for(int i=0;i<90;i++)
 	{
+		/* Solveur A* parallèle (HDA*) limité à 5 millions de noeuds et 700Mo
+		 * pour tous les threads */
+		if(hdaSolver)
+		{
+			BotHDA* solver = new BotHDA(base, pack->getLevelList()[i], 5000000,
+					700, threadNumber, 870967, 51827, 3, false, true);
+			solver->resolve();
+			solver->getStats()->print();
+			solver->getStats()->print("solutions.txt");
+			delete solver;
+			continue;
+		}
+
 		/* Solveur IDA* en "recherche rapide" limité à 5 millions de noeuds et 700Mo
 		 * Un pré-traitement de 3 caisses est lancé avant la création de l'arbre
 		 * de recherche */
@@ -55,6 +126,9 @@ int main(int argc, char **argv)
 //		BotIDA* solver = new BotIDA(base, pack->getLevelList()[i], 5000000,
 //				700, 870967, 51827, 3, false, false);
 
+		solver->setThresholdGrowth(thresholdGrowth);
+		solver->setFringeSearch(fringeSearch);
+		solver->setThreadNumber(idaThreadNumber);
 		solver->resolve();
 		delete solver;
 
@@ -0,0 +1,187 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/* Microbenchmark of Zone word operations ("make bench").
+ *
+ * ./zonebench                  : ns by call for zones of 1 to 64 words
+ * ./zonebench 100Boxes.slc ... : number of levels of each pack for every
+ *                                zone size (words), then ns by call for the
+ *                                sizes found in these packs
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "include/Base.h"
+#include "include/Pack.h"
+#include "include/Level.h"
+#include "include/Solver/Zone.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** Number of zones of each tested size (pairs of zones are compared) */
+static const int ZONEBENCH_ZONES = 512;
+/** Number of passes on every zone of a size */
+static const int ZONEBENCH_PASSES = 2000;
+/** Biggest number of words tested */
+static const int ZONEBENCH_MAXWORDS = 64;
+
+/**
+ * Time in nanoseconds (monotonic clock)
+ * @return actual time
+ */
+static long long getBenchTime(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (long long)t.tv_sec*1000000000LL + t.tv_nsec;
+}
+
+/**
+ * Number of zone positions of a level (every position that is not a wall or
+ * outside the level, like Solver::initZoneToLevelPos)
+ * @param level level to measure
+ * @return length of zones of this level
+ */
+static int getZoneLength(const Level* level)
+{
+	int length = 0;
+	int size = level->getRowsNumber()*level->getColsNumber();
+	for(int i=0;i<size;i++)
+	{
+		char c = level->readPos(i);
+		if(c != '#' && c != ' ')
+			length++;
+	}
+
+	return length;
+}
+
+/**
+ * Time Zone operations used by the solvers on zones of a given size. Zones
+ * are sparse like boxes zones, half of the pairs are equal.
+ * @param words number of words of zones
+ */
+static void benchWords(int words)
+{
+	int length = words*8*sizeof(unsigned int);
+	Zone** zones = (Zone**)malloc(2*ZONEBENCH_ZONES*sizeof(Zone*));
+	for(int i=0;i<2*ZONEBENCH_ZONES;i++)
+	{
+		if(i%4 == 1)
+			zones[i] = new Zone(zones[i-1]);
+		else
+		{
+			zones[i] = new Zone(length);
+			for(int j=0;j<length/8;j++)
+				zones[i]->write1ToPos(rand()%length);
+		}
+	}
+	Zone* dest = new Zone(length);
+
+	volatile int sum = 0;
+	long long calls = (long long)ZONEBENCH_PASSES*ZONEBENCH_ZONES;
+
+	long long t = getBenchTime();
+	for(int r=0;r<ZONEBENCH_PASSES;r++)
+		for(int i=0;i<ZONEBENCH_ZONES;i++)
+			sum += zones[2*i]->isEgal(zones[2*i+1]);
+	double egal = (double)(getBenchTime()-t)/calls;
+
+	t = getBenchTime();
+	for(int r=0;r<ZONEBENCH_PASSES;r++)
+		for(int i=0;i<ZONEBENCH_ZONES;i++)
+			sum += zones[2*i]->isIncludedIn(zones[2*i+1]);
+	double included = (double)(getBenchTime()-t)/calls;
+
+	t = getBenchTime();
+	for(int r=0;r<ZONEBENCH_PASSES;r++)
+		for(int i=0;i<ZONEBENCH_ZONES;i++)
+			sum += zones[2*i]->intersects(zones[2*i+1]);
+	double intersects = (double)(getBenchTime()-t)/calls;
+
+	t = getBenchTime();
+	for(int r=0;r<ZONEBENCH_PASSES;r++)
+		for(int i=0;i<ZONEBENCH_ZONES;i++)
+			dest->applyOrWith(zones[2*i+1]);
+	double applyOr = (double)(getBenchTime()-t)/calls;
+
+	printf("words %2d : isEgal %6.2f  isIncludedIn %6.2f  intersects %6.2f"
+			"  applyOrWith %6.2f ns\n",
+			words, egal, included, intersects, applyOr);
+
+	delete dest;
+	for(int i=0;i<2*ZONEBENCH_ZONES;i++)
+		delete zones[i];
+	free(zones);
+}
+
+int main(int argc, char **argv)
+{
+	int* levelsByWords = (int*)malloc((ZONEBENCH_MAXWORDS+1)*sizeof(int));
+	for(int i=0;i<=ZONEBENCH_MAXWORDS;i++)
+		levelsByWords[i] = 0;
+
+	if(argc < 2)
+	{
+		for(int w=1;w<=ZONEBENCH_MAXWORDS;w*=2)
+			levelsByWords[w] = 1;
+	}
+	else
+	{
+		char* baseArgs[] = {argv[0], (char*)"michael"};
+		Base* base = new Base(2, baseArgs);
+		for(int p=1;p<argc;p++)
+		{
+			Pack* pack = new Pack(base, argv[p], "michael");
+			int* packLevels = (int*)malloc(
+					(ZONEBENCH_MAXWORDS+1)*sizeof(int));
+			for(int i=0;i<=ZONEBENCH_MAXWORDS;i++)
+				packLevels[i] = 0;
+
+			for(int i=0;i<pack->getN();i++)
+			{
+				Zone zone(getZoneLength(pack->getLevelList()[i]));
+				int words = zone.getNumberCell();
+				if(words > ZONEBENCH_MAXWORDS)
+					words = ZONEBENCH_MAXWORDS;
+				packLevels[words]++;
+				levelsByWords[words]++;
+			}
+
+			printf("%s :", argv[p]);
+			for(int i=0;i<=ZONEBENCH_MAXWORDS;i++)
+			{
+				if(packLevels[i] > 0)
+					printf(" %d words (%d levels)", i, packLevels[i]);
+			}
+			printf("\n");
+
+			free(packLevels);
+			delete pack;
+		}
+		delete base;
+	}
+
+	for(int i=1;i<=ZONEBENCH_MAXWORDS;i++)
+	{
+		if(levelsByWords[i] > 0)
+			benchWords(i);
+	}
+
+	free(levelsByWords);
+
+	return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
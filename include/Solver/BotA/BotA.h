@@ -29,6 +29,7 @@
 #include "../Deadlock.h"
 #include "../Stats.h"
 #include "../HashTable.h"
+#include "../GoalRoom.h"
 
 class BotA : public Solver
 {
@@ -40,6 +41,11 @@ protected:
 	 */
 	int minReject;
 	bool quickSearch; /**< Test penalties of every nodes */
+	/**
+	 * TreeNodes rejected by costLimit but kept in the tree for next iteration
+	 * (fringe search). NULL if rejected treeNodes are deleted
+	 */
+	HashTable* fringeTable;
 
 public:
     virtual const char* SOLVER_NAME() = 0; /**< Name of this solver */
@@ -65,6 +71,11 @@ public:
 			int deadlockedBoxesSearch = 2, bool onlyPushNumber = false,
 			bool quickSearch = false);
 
+	/**
+	 * Destructor
+	 */
+	virtual ~BotA();
+
 	/* --------*/
 	/* Getters */
 	/* --------*/
@@ -74,6 +85,8 @@ public:
 	inline int getCostLimit(void) const { return costLimit; }
 	/** @Return quick search */
 	inline int getQuickSearch(void) const { return quickSearch; }
+	/** @Return treeNodes kept for next iteration (NULL if none) */
+	inline HashTable* getFringeTable(void) const { return fringeTable; }
 
 	/**
 	 * Return size in octets of the actual state of this solver
@@ -125,10 +138,31 @@ protected:
 	 * @param treeNode treenode we want to look if it's new or beter than
 	 * anything existing
 	 * @param counter counter of children of actual treeNode
+	 * @param kept set to true if treeNode is rejected by costLimit but kept
+	 * in fringeTable (it must not be deleted)
 	 * @return true if it's already searched and doesn't need to be added.
 	 * false if it's not already searched and we need to add it.
 	 */
-	bool workOnAlreadySearched(TreeNode* treeNode, int* counter);
+	bool workOnAlreadySearched(TreeNode* treeNode, int* counter, bool* kept);
+
+	/**
+	 * Keep a treeNode rejected by costLimit in fringeTable, or give its cost
+	 * to the same treeNode already kept if it's smaller
+	 * @param treeNode rejected treenode
+	 * @param counter counter of children of actual treeNode
+	 * @return true if treeNode is added to fringeTable
+	 */
+	bool workOnRejected(TreeNode* treeNode, int* counter);
+
+	/**
+	 * If an accepted treeNode is kept in fringeTable, the kept treeNode gets
+	 * its cost and parent and is moved to the waiting list
+	 * @param treeNode accepted treenode
+	 * @param counter counter of children of actual treeNode
+	 * @return true if treeNode was in fringeTable (and doesn't need to be
+	 * added)
+	 */
+	bool workOnFringe(TreeNode* treeNode, int* counter);
 
 	/**
 	 * Get first treeNode from closeNodeList and delete it from the list
@@ -147,6 +181,82 @@ protected:
 	 */
 	Child** findPonderedChildren(TreeNode* treeNode);
 
+	/**
+	 * Get list of children of a node (simple pushes, pushes through tunnels
+	 * and macro children) without using hash tables
+	 * @param node node we want to find children
+	 * @param pushes tab of pushes of the caller (at least 4 by box), only
+	 * used until children are returned
+	 * @return list of children (terminated by NULL) with their cost
+	 */
+	Child** findNodeChildren(Node* node, Push* pushes);
+
+	/**
+	 * Get pushes of a node that can make a child : pushes kept by the
+	 * PI-corral and goal room restrictions, carried through tunnels and not
+	 * deadlocked. No node is created.
+	 * @param node node we want to find pushes
+	 * @param pushes tab where pushes are written (at least 4 by box)
+	 * @return number of pushes written in pushes
+	 */
+	int findNodePushes(const Node* node, Push* pushes);
+
+	/**
+	 * Keep only pushes of a box of the node's PI-corral (if the node has a
+	 * PI-corral). Kept pushes are moved at the beginning of pushes tab.
+	 * Macro children are not concerned (they are only shortcuts of simple
+	 * pushes).
+	 * @param node parent node of the pushes
+	 * @param pushes pushes found for node
+	 * @param pushNumber number of pushes found for node in pushes tab
+	 * @return number of kept pushes
+	 */
+	int restrictToPICorral(const Node* node, Push* pushes, int pushNumber);
+
+	/**
+	 * Remove pushes of packed boxes of the goal room (first goals of the
+	 * order to fill it). Kept pushes are moved at the beginning of pushes tab.
+	 * @param node parent node of the pushes
+	 * @param pushes pushes found for node
+	 * @param pushNumber number of pushes found for node in pushes tab
+	 * @return number of kept pushes
+	 */
+	int restrictToGoalRoom(const Node* node, Push* pushes, int pushNumber);
+
+	/**
+	 * Remove pushes found deadlocked by Deadlock::deadlockedPush. Kept pushes
+	 * are moved at the beginning of pushes tab.
+	 * @param node parent node of the pushes
+	 * @param pushes pushes found for node
+	 * @param pushNumber number of pushes found for node in pushes tab
+	 * @return number of kept pushes
+	 */
+	int removeDeadlockedPushes(const Node* node, Push* pushes,
+			int pushNumber);
+
+	/**
+	 * Remove pushes whose node is already in open or close hashtable with a
+	 * smaller or equal g(x) : their treeNode would be deleted without any
+	 * change by workOnAlreadySearched. Only made without cost limit and
+	 * fringe (rejected nodes are kept in the fringe) and if getPushG knows
+	 * g(x). Kept pushes are moved at the beginning of pushes tab.
+	 * @param treeNode parent treeNode of the pushes
+	 * @param pushes pushes found for node of treeNode
+	 * @param pushNumber number of pushes found in pushes tab
+	 * @return number of kept pushes
+	 */
+	int removeSearchedPushes(TreeNode* treeNode, Push* pushes,
+			int pushNumber);
+
+	/**
+	 * Cost from the initial treenode to the child of a push, known before
+	 * its node is created
+	 * @param parentTreeNode treeNode the push is made from
+	 * @param push push of the child
+	 * @return g(x) of the child, -1 if it needs the node
+	 */
+	virtual int getPushG(TreeNode* parentTreeNode, const Push* push) const;
+
 	/**
 	 * Add a new TreeNode to the waiting list at the right position.
 	 * New Treenode is added TO THE CORRECT PLACE DEPENDING OF ITS COST
@@ -30,7 +30,7 @@ class BotBestPushesS_Penalties;
 class BotBestPushesS : public BotA
 {
 protected:
-	int** costTable; /**< cost table of this level */
+	const int* const* costTable; /**< cost table of this level (rows in box index space) */
 	BotBestPushesS_Penalties* penaltiesEngine; /**< cost table of this level */
 	Level* emptyLevel; /**< Level without boxes */
 
@@ -68,7 +68,19 @@ public:
 	/* Getters */
 	/* --------*/
 	/** @Return costTable */
-	inline int** getCostTable(void) const { return costTable; }
+	inline const int* const* getCostTable(void) const { return costTable; }
+	/**
+	 * Minimum number of pushes of a box to a position (see costTable)
+	 * @param zonePos zone position of the box
+	 * @param goalPos zone position of the destination
+	 * @return number of pushes, INT_MAX if the box can't reach it (or is on
+	 * a dead square)
+	 */
+	inline int getCost(int zonePos, int goalPos) const
+	{
+		int boxPos = zoneToBoxPos[zonePos];
+		return (boxPos == -1) ? INT_MAX : costTable[boxPos][goalPos];
+	}
 	/** @Return penaltiesEngine */
 	inline BotBestPushesS_Penalties* getPenaltiesEngine(void) const
 	{ return penaltiesEngine; }
@@ -151,6 +163,14 @@ protected:
 	 */
 	virtual int g(TreeNode* treeNode, int pushCost) const;
 
+	/**
+	 * Number of pushes from the start until the child of a push (see g)
+	 * @param parentTreeNode treeNode the push is made from
+	 * @param push push of the child
+	 * @return cost value from start to the child
+	 */
+	virtual int getPushG(TreeNode* parentTreeNode, const Push* push) const;
+
 	/**
 	 * Estimated number of pushes from this node to a solution
 	 * @param treeNode to be computed
@@ -160,11 +180,13 @@ protected:
 
 	/**
 	 * Create or load a cost Table for this level. A cost table is a  2
-	 * dimensions table with, for each zone representation position of level,
-	 * the associated min number of pushes to each goal. If a position can't
-	 * reach a goal, value is set to INT_MAX
+	 * dimensions table with, for each box index position of level (dead
+	 * squares excluded), the associated min number of pushes to each zone
+	 * representation position. If a position can't be reached, value is set
+	 * to INT_MAX. File of the table keeps a row for every zone position (it
+	 * is shared by levels with the same walls and other goals).
 	 * exemple : costTable[4][2] is minimum number of pushes to join a box on
-	 * 5th zone position to third goal.
+	 * 5th box index position to third zone position.
 	 * @return costTable of this level
 	 */
 	int** initCostTable();
@@ -172,7 +194,7 @@ protected:
 	/**
 	 * Create cost Table for this level.
 	 * exemple : costTable[4][2] is minimum number of pushes to join a box on
-	 * 5th zone position to third goal.
+	 * 5th box index position to third zone position.
 	 * @return created costable
 	 */
 	int** createCostTable();
@@ -180,19 +202,29 @@ protected:
 	/**
 	 * Load a cost Table of this level from a file.
 	 * exemple : costTable[4][2] is minimum number of pushes to join a box on
-	 * 5th zone position to third goal.
-	 * @param file from where we want to load costTable
-	 * @return loaded costable
+	 * 5th box index position to third zone position.
+	 * @param file from where we want to load costTable (a row for every zone
+	 * position)
+	 * @return loaded costable (NULL if file doesn't match this level)
 	 */
 	int** loadCostTable(char* file);
 
 	/**
 	 * Save costTable in a appropriated file
-	 * @param cTable cost table we want to save
+	 * @param cTable cost table we want to save (a row for every zone
+	 * position)
 	 * @param zoneLength zoneLength of this level
 	 */
 	void saveCostTable(int** cTable, int zoneLength);
 
+	/**
+	 * Keep rows of box index positions of a cost table with a row for every
+	 * zone position (other rows are freed)
+	 * @param zoneTable cost table with a row for every zone position (freed)
+	 * @return cost table with a row for every box index position
+	 */
+	int** createBoxRows(int** zoneTable) const;
+
 	/**
 	 * Create an assignation matrix for this treeNode.
 	 * An assignation matrix is a 2 dimensions square matrix with boxes positions
@@ -208,6 +240,18 @@ protected:
 	BotBestPushesS_Matrix<double>*
 	createAssignationMatrix(const int* boxesPositions,
 			const int* goalsPositions) const;
+
+	/**
+	 * Packed boxes of the goal room (see GoalRoom) stay on their goal : a
+	 * packed box is only assigned to its goal and its goal to this box.
+	 * @param assignMatrix assignation matrix of this treeNode
+	 * @param boxesZone boxes of this treeNode
+	 * @param boxesPositions boxes positions of rows of assignMatrix
+	 * @param goalsPositions goals positions of cols of assignMatrix
+	 */
+	void freezePackedBoxes(BotBestPushesS_Matrix<double>* assignMatrix,
+			const Zone* boxesZone, const int* boxesPositions,
+			const int* goalsPositions) const;
 };
 
 #endif /*BOTBESTPUSHESS_H_*/
@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 #include "../Solver.h"
 #include "../BotBestPushesS/BotBestPushesS.h"
 #include "../Node.h"
@@ -41,6 +42,8 @@ protected:
 	int* penaltiesTestTab; /**< Tab of current boxes positions in penalties test */
 	int penaltiesTestTabLength; /**< Length of deadlockTestTab */
 	Level* emptyLevel; /**< Level with no boxes or pusher */
+	Zone* usedBoxesZone; /**< Boxes already penalized while computing a
+	penalty (kept between calls instead of creating a zone for each call) */
 
 	const Level* level; /**< Initial level we want to solve */
 	const Zone* goalZone; /**< Zone representation of all goals in this level */
@@ -48,6 +51,9 @@ protected:
 	const int zoneToLevelPosLength; /**< Length of translation table */
 	const int* levelToZonePos; /**< translation table between old positions in level and new positions in zone */
 
+	/** Penalties file of a level is read and written by solvers of many
+	 * threads (workers of BotHDA and their analyzes) */
+	static pthread_mutex_t fileMutex;
 
 public:
 	/**
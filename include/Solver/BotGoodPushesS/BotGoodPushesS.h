@@ -59,6 +59,21 @@ public:
 	 * @return always 0
 	 */
 	virtual int g(TreeNode* treeNode, int pushCost) const;
+
+	/**
+	 * Cost from the start until the child of a push
+	 * @param parentTreeNode treeNode the push is made from
+	 * @param push push of the child
+	 * @return always 0
+	 */
+	virtual int getPushG(TreeNode* parentTreeNode, const Push* push) const;
+
+	/**
+	 * Goal room is filled in order (see GoalRoom) : this solver doesn't keep
+	 * the best number of pushes
+	 * @return always true
+	 */
+	virtual bool usesPackingOrder(void) const;
 };
 
 #endif /*BOTGOODPUSHESS_H_*/
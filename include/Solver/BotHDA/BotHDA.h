@@ -0,0 +1,200 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Hash distributed A* (HDA*) based on best pushes number : the same
+ * A* search than BotBestPushesS with many threads.
+ *
+ * Each node is owned by one worker (BotHDA_Worker), found with a Zobrist key
+ * of its boxes and pusher zones. A worker searches its own nodes in
+ * best-first order and sends children to their owner through lock-free
+ * queues.
+ *
+ * A found solution is only the best one when no worker has a waiting node
+ * with a smaller f(x) and no node is sent : "activity" counts active workers
+ * and sent nodes not received yet. The search ends when it's 0.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTHDA_H_
+#define BOTHDA_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <pthread.h>
+#include "../Stats.h"
+#include "BotHDA_Worker.h"
+#include "BotHDA_Queue.h"
+
+class BotHDA
+{
+protected:
+	Base* base; /**< Main class of the game */
+	Level* level; /**< Initial level we want to solve */
+	int nodeNumber; /**< Number of explored nodes (every worker) */
+	int maxNodeNumber; /**< Max number of explored nodes (every worker) */
+	int maxRamSize; /**< Max allowed ram size */
+	int threadNumber; /**< Number of workers (one thread each) */
+	/** number of boxes to use when testing every
+	 * possible positions of deadlock */
+	int deadlockedBoxesSearch;
+	bool onlyPushNumber; /**< Only get push number but not the path */
+	bool quickSearch; /**< Test penalties of every nodes */
+	Stats* stats; /**< Stats of this solving */
+	BotHDA_Worker** workers; /**< Every worker */
+	unsigned int* boxesKeys; /**< Zobrist key of a box on each zone position */
+	unsigned int* pusherKeys; /**< Zobrist key of each first position of
+	pusher zone */
+	int keysLength; /**< Length of boxesKeys and pusherKeys */
+	int bestCost; /**< Number of pushes of best solution (INT_MAX if none) */
+	int activity; /**< Active workers and sent nodes not received yet */
+	bool stopped; /**< True if limit of nodes or ram is reached */
+	bool ramChecking; /**< True while a worker reads the size of process */
+
+public:
+	int OPENTABLE_SIZE; /**< Size of hashtable (each worker) */
+	int CLOSETABLE_SIZE; /**< Size of hashtable (each worker) */
+	/** Size of process is read every RAMCHECK_PERIOD nodes (every worker) */
+	static const int RAMCHECK_PERIOD = 1000;
+	/** Name of this solver */
+	virtual const char* SOLVER_NAME(){return "BotHDA";}
+
+	/**
+	 * Constructor for a solver of a level
+	 * @param base main class of the game
+	 * @param level Level to be used
+	 * @param maxNodeNumber Limit number of nodes to explore (every worker)
+	 * @param maxRamSize Limit max ram size to allocate
+	 * @param threadNumber Number of workers (one thread each)
+	 * @param openTableSize size of Open Table of each worker (hashtable)
+	 * @param closeTableSize size of Close Table of each worker (hashtable)
+	 * @param deadlockedBoxesSearch number of boxes to use when testing every
+	 * possible positions of deadlock
+	 * @param onlyPushNumber only keep number of pushes in Stats object.
+	 * don't generate solution Path (CPU saving for deadlocks and penalties)
+	 * @param quickSearch don't test penalties of every nodes before adding
+	 * it on the tree
+	 */
+	BotHDA(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
+			int threadNumber, int openTableSize = 870967,
+			int closeTableSize = 51827, int deadlockedBoxesSearch = 2,
+			bool onlyPushNumber = false, bool quickSearch = false);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~BotHDA();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return Main class of the game */
+	inline Base* getBase(void) const { return base; }
+	/** @Return Level assigned to solver */
+	inline const Level* getLevel(void) const { return level; }
+	/** @Return nodeNumber */
+	inline const int getNodeNumber(void) const { return nodeNumber; }
+	/** @Return maximum Node Number */
+	inline const int getMaxNodeNumber(void) const { return maxNodeNumber; }
+	/** @Return maximum ram size */
+	inline const int getMaxRamSize(void) const { return maxRamSize; }
+	/** @Return number of workers */
+	inline const int getThreadNumber(void) const { return threadNumber; }
+	/** @Return stats of this level */
+	inline const Stats* getStats(void) const { return stats; }
+	/** @Return worker of index i */
+	inline BotHDA_Worker* getWorker(int i) const { return workers[i]; }
+
+	/** @Return Number of pushes of best solution (INT_MAX if none) */
+	inline int getBestCost(void)
+	{ return __atomic_load_n(&bestCost, __ATOMIC_ACQUIRE); }
+	/** @Return Active workers and sent nodes not received yet */
+	inline int getActivity(void)
+	{ return __atomic_load_n(&activity, __ATOMIC_ACQUIRE); }
+	/** @Return true if limit of nodes is reached */
+	inline bool isStopped(void)
+	{ return __atomic_load_n(&stopped, __ATOMIC_ACQUIRE); }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Start to resolve with parameters given to constructor
+	 */
+	void resolve(void);
+
+	/**
+	 * Find worker owning a node
+	 * @param node node to test
+	 * @return index of the worker
+	 */
+	int getOwner(const Node* node) const;
+
+	/**
+	 * Send a node to a worker (called by every thread)
+	 * @param owner index of the worker
+	 * @param message node sent (deleted by owner)
+	 */
+	void send(int owner, BotHDA_Message* message);
+
+	/**
+	 * Add a value to activity (called by every thread)
+	 * @param value -1 when a worker becomes inactive or when an active
+	 * worker receives a node
+	 */
+	inline void addActivity(int value)
+	{ __atomic_add_fetch(&activity, value, __ATOMIC_ACQ_REL); }
+
+	/**
+	 * Keep a solution if it's better than best one (called by every thread)
+	 * @param cost number of pushes of solution
+	 * @return true if it's the best solution
+	 */
+	bool offerSolution(int cost);
+
+	/**
+	 * Count an expanded treeNode (called by every thread). Size of process
+	 * is compared to maxRamSize every RAMCHECK_PERIOD nodes.
+	 * @return false if limit of nodes or ram is reached (every worker stops)
+	 */
+	bool countNode(void);
+
+protected:
+	/**
+	 * Create workers (initialized one after the other : files of deadlocks
+	 * and penalties are created by first one)
+	 */
+	void initWorkers(void);
+
+	/**
+	 * Create Zobrist keys of every zone position
+	 */
+	void initKeys(void);
+
+	/**
+	 * Send first node to its owner
+	 */
+	void sendFirstNode(void);
+
+	/**
+	 * Start a thread for each worker and wait for the end of the search
+	 */
+	void runWorkers(void);
+
+	/**
+	 * Create stats of best solution (path from first node to solution
+	 * through treeNodes of every worker)
+	 */
+	void createStats(void);
+
+private:
+	BotHDA(const BotHDA& hda);
+	BotHDA& operator=(const BotHDA& hda);
+};
+
+#endif /*BOTHDA_H_*/
@@ -0,0 +1,80 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Lock-free queue of generated children sent to a worker of BotHDA
+ *
+ * Many producers (every worker) and only one consumer (owner of the queue).
+ * Messages are linked together : push is one atomic exchange and pop doesn't
+ * use any atomic read-modify-write.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTHDA_QUEUE_H_
+#define BOTHDA_QUEUE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+class Node;
+class TreeNode;
+
+/**
+ * @brief More a usefull structure than a class : a child sent to its owner
+ */
+class BotHDA_Message
+{
+public :
+	Node* node; /**< Child (created for solver of the owner) */
+	int g; /**< g(x) of child */
+	int f; /**< f(x) of child */
+	TreeNode* remoteParent; /**< Expanded treeNode (of sender) */
+	BotHDA_Message* next; /**< Next message of queue */
+
+	BotHDA_Message(Node* node, int g, int f, TreeNode* remoteParent);
+	~BotHDA_Message();
+};
+
+class BotHDA_Queue
+{
+protected:
+	BotHDA_Message* head; /**< Last pushed message (producers side) */
+	BotHDA_Message* tail; /**< Next message to pop (consumer side) */
+	BotHDA_Message* stub; /**< Empty message to keep queue linked */
+
+public:
+	/**
+	 * Constructor
+	 */
+	BotHDA_Queue();
+
+	/**
+	 * Destructor : messages not popped are deleted with their node
+	 */
+	~BotHDA_Queue();
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Add a message at the end of the queue (can be called by every thread)
+	 * @param message message to add (deleted by consumer)
+	 */
+	void push(BotHDA_Message* message);
+
+	/**
+	 * Get first message of the queue (only called by owner of the queue)
+	 * @return first message (NULL if empty or if a push is not finished)
+	 */
+	BotHDA_Message* pop(void);
+
+private:
+	BotHDA_Queue(const BotHDA_Queue& queue);
+	BotHDA_Queue& operator=(const BotHDA_Queue& queue);
+};
+
+#endif /*BOTHDA_QUEUE_H_*/
@@ -0,0 +1,53 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief A version of BotA_TreeNode for workers of BotHDA. Parent of a
+ * treeNode is often owned by another worker : it's only kept as a link to
+ * find the path of the solution (the treeNode is not attached to it).
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTHDA_TREENODE_H_
+#define BOTHDA_TREENODE_H_
+
+#include <stdlib.h>
+#include "../BotA/BotA_TreeNode.h"
+
+class BotHDA_TreeNode : public BotA_TreeNode
+{
+protected:
+	/** treeNode expanded to find this one with actual g(x) (NULL for first
+	 * node) */
+	TreeNode* remoteParent;
+
+public:
+	/**
+	 * Constructor for new node with cost
+	 * @param node Node to be stocked on this item
+	 * @param f f(x)
+	 * @param g g(x)
+	 * @param remoteParent treeNode expanded to find this one
+	 */
+	BotHDA_TreeNode(Node* node, const int f, const int g,
+			TreeNode* remoteParent);
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return treeNode expanded to find this one with actual g(x) */
+	inline TreeNode* getRemoteParent(void) const { return remoteParent; }
+
+	/* --------*/
+	/* Setters */
+	/* --------*/
+	/** @Return Assign treeNode expanded to find this one */
+	inline void setRemoteParent(TreeNode* remoteParent)
+	{ this->remoteParent = remoteParent; }
+};
+
+#endif /*BOTHDA_TREENODE_H_*/
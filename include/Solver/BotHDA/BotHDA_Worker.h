@@ -0,0 +1,143 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief One thread of BotHDA : A* search of nodes owned by this worker
+ *
+ * Same costs, children, deadlocks and penalties than BotBestPushesS. Open and
+ * close hash tables and waiting list only keep nodes owned by this worker :
+ * children of an expanded node are sent to their owner (BotHDA::getOwner)
+ * with their g(x) and f(x). A received node already expanded with a bigger
+ * g(x) is searched again.
+ *
+ * TreeNodes are not attached to their parent (often owned by another
+ * worker) : every treeNode is kept until the worker is deleted.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTHDA_WORKER_H_
+#define BOTHDA_WORKER_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../BotBestPushesS/BotBestPushesS.h"
+#include "BotHDA_TreeNode.h"
+#include "BotHDA_Queue.h"
+
+class BotHDA;
+
+class BotHDA_Worker : public BotBestPushesS
+{
+protected:
+	BotHDA* hda; /**< Search shared by every worker */
+	int workerId; /**< Index of this worker in hda */
+	BotHDA_Queue* queue; /**< Children sent to this worker */
+	/** Best solution found by this worker (NULL if none) */
+	TreeNode* solutionTreeNode;
+
+public:
+	/** Name of this solver */
+	virtual const char* SOLVER_NAME(){return "BotHDA_Worker";}
+
+	/**
+	 * Constructor for a worker of a level
+	 * @param base main class of the game
+	 * @param level Level to be used
+	 * @param hda Search shared by every worker
+	 * @param workerId Index of this worker in hda
+	 * @param maxNodeNumber Limit number of nodes to explore (by every worker)
+	 * @param maxRamSize Limit max ram size to allocate
+	 * @param openTableSize size of Open Table to allocate (hashtable)
+	 * @param closeTableSize size of Close Table to allocate (hashtable)
+	 * @param deadlockedBoxesSearch number of boxes to use when testing every
+	 * possible positions of deadlock
+	 * @param onlyPushNumber only keep number of pushes in Stats object.
+	 * don't generate solution Path (CPU saving for deadlocks and penalties)
+	 * @param quickSearch don't test penalties of every nodes before adding
+	 * it on the tree
+	 */
+	BotHDA_Worker(Base* base, Level* level, BotHDA* hda, int workerId,
+			int maxNodeNumber, int maxRamSize, int openTableSize,
+			int closeTableSize, int deadlockedBoxesSearch = 2,
+			bool onlyPushNumber = false, bool quickSearch = false);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~BotHDA_Worker();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return Children sent to this worker */
+	inline BotHDA_Queue* getQueue(void) const { return queue; }
+	/** @Return Best solution found by this worker (NULL if none) */
+	inline TreeNode* getSolutionTreeNode(void) const
+	{ return solutionTreeNode; }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Initialize level (and first node for first worker)
+	 */
+	void start(void);
+
+	/**
+	 * Thread function : search until every worker is finished
+	 * @param worker worker to use
+	 * @return NULL
+	 */
+	static void* run(void* worker);
+
+protected:
+	/**
+	 * Only first worker creates (and analyzes) first node : penalties found
+	 * are saved for other workers. First node is not in the waiting list :
+	 * it's sent to its owner by BotHDA
+	 */
+	virtual void initStartingNode(void);
+
+	/**
+	 * Search received nodes in best-first order until every worker has
+	 * nothing to search under the best solution and no node is sent
+	 */
+	virtual void process(void);
+
+	/**
+	 * Get first treeNode of the waiting list and move it to open table
+	 * @return first treeNode (NULL if empty or if it can't give a better
+	 * solution)
+	 */
+	TreeNode* nextTreeNode(void);
+
+	/**
+	 * Send every child of a treeNode (not deadlocked and under best solution)
+	 * to its owner
+	 * @param treeNode expanded treeNode
+	 */
+	void expand(TreeNode* treeNode);
+
+	/**
+	 * Add a received node to the waiting list or give its g(x) and parent to
+	 * the same treeNode if it's smaller
+	 * @param message received node (deleted)
+	 */
+	void receive(BotHDA_Message* message);
+
+	/**
+	 * Delete every treeNode of a hash table
+	 * @param table open or close table
+	 */
+	void deleteTreeNodes(HashTable* table);
+
+private:
+	BotHDA_Worker(const BotHDA_Worker& worker);
+	BotHDA_Worker& operator=(const BotHDA_Worker& worker);
+};
+
+#endif /*BOTHDA_WORKER_H_*/
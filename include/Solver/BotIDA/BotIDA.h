@@ -17,6 +17,10 @@
 #include <stdlib.h>
 #include "../BotIDA/BotIDA.h"
 #include "../BotBestPushesS/BotBestPushesS.h"
+#include "../Deadlock.h"
+#include "../VerdictCache.h"
+
+class BotIDA_Search;
 
 class BotIDA
 {
@@ -32,12 +36,25 @@ protected:
 	bool onlyPushNumber; /**< Only get push number but not the path */
 	bool quickSearch; /**< Test penalties of every nodes */
 	Stats* stats; /**< Stats of this solving */
+	/** Deadlock verdicts shared by every iteration on this level */
+	VerdictCache* verdictCache;
+	/** Wanted number of nodes of an iteration (percent of previous one) */
+	int thresholdGrowth;
+	/** Iterations start from treeNodes rejected by previous one (fringe
+	 * search) instead of first node */
+	bool fringeSearch;
+	/** Number of threads searching each iteration (work stealing) */
+	int threadNumber;
 
 public:
 	/** Name of this solver */
 	int OPENTABLE_SIZE; /**< Size of hashtable */
 	int CLOSETABLE_SIZE; /**< Size of hashtable */
 	virtual const char* SOLVER_NAME(){return "BotIDA";}
+	/** Default wanted number of nodes of an iteration (percent of previous
+	 * one). 100 or less : next cost limit is the smallest rejected f(x).
+	 * Bigger values grow the cost limit faster (see setThresholdGrowth) */
+	static const int THRESHOLD_GROWTH = 100;
 
 	/**
 	 * Constructor for a solver of a level
@@ -81,6 +98,36 @@ public:
 	/** @Return stats of this level */
 	inline const Stats* getStats(void) const { return stats; }
 
+	/* --------*/
+	/* Setters */
+	/* --------*/
+	/**
+	 * Set wanted number of nodes of an iteration. Bigger than 100, next cost
+	 * limit is chosen from the histogram of rejected f(x) : fewer iterations,
+	 * but a found solution must be searched again under its cost.
+	 * @param thresholdGrowth percent of previous iteration (100 or less : next
+	 * cost limit is the smallest rejected f(x), default)
+	 */
+	inline void setThresholdGrowth(int thresholdGrowth)
+	{ this->thresholdGrowth = thresholdGrowth; }
+
+	/**
+	 * Choose search of every iteration
+	 * @param fringeSearch true to keep searched and rejected treeNodes
+	 * between iterations (BotIDA_Fringe), false for depth-first searches
+	 * from first node (BotIDA_Search)
+	 */
+	inline void setFringeSearch(bool fringeSearch)
+	{ this->fringeSearch = fringeSearch; }
+
+	/**
+	 * Set number of threads searching each iteration
+	 * @param threadNumber more than 1 : sub-trees of every iteration are
+	 * searched by many threads (BotIDA_Parallel). Not used by fringe search
+	 */
+	inline void setThreadNumber(int threadNumber)
+	{ this->threadNumber = threadNumber; }
+
 	/* -------*/
 	/* Others */
 	/* -------*/
@@ -128,15 +175,17 @@ protected:
 	/**
 	 * Initialize correct iteration cost of IDA* from a file or directly
 	 * generated.
+	 * @param solver search used by every iteration
 	 * @return initial cost
 	 */
-	int initInitialCost();
+	int initInitialCost(BotIDA_Search* solver);
 
 	/**
-	 * Generate correct iteration cost of IDA*
+	 * Generate correct iteration cost of IDA* (f(x) of first node)
+	 * @param solver search used by every iteration
 	 * @return initial cost
 	 */
-	int createInitialCost();
+	int createInitialCost(BotIDA_Search* solver);
 
 	/**
 	 * Load correct iteration cost of IDA* from a file
@@ -0,0 +1,73 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Transposition table shared by every worker of BotIDA_Parallel
+ *
+ * Same cells and replacement than BotIDA_TranspositionTable. Cells are
+ * split in groups protected by a mutex : threads only wait for each other
+ * when they use cells of the same group at the same time.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTIDA_CONCURRENTTABLE_H_
+#define BOTIDA_CONCURRENTTABLE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "BotIDA_TranspositionTable.h"
+
+class BotIDA_ConcurrentTable : public BotIDA_TranspositionTable
+{
+protected:
+	pthread_mutex_t* locks; /**< Mutex of each group of cells */
+
+public:
+	/** Number of groups of cells (one mutex each) */
+	static const int LOCKS_NUMBER = 1024;
+
+	/**
+	 * Constructor
+	 * @param length number of cells
+	 * @param numberCell number of cells of boxes and pusher zones
+	 */
+	BotIDA_ConcurrentTable(int length, int numberCell);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~BotIDA_ConcurrentTable();
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Find a node in the table (called by every thread)
+	 * @param node node we want to find
+	 * @param iteration iteration where node was seen (returned)
+	 * @param g g(x) of node when it was seen (returned)
+	 * @param h lower bound of h(x) of node (returned)
+	 * @return true if node is in the table
+	 */
+	virtual bool find(const Node* node, int* iteration, int* g, int* h);
+
+	/**
+	 * Save a node in the table (called by every thread)
+	 * @param node node we want to save
+	 * @param iteration actual iteration
+	 * @param g g(x) of node
+	 * @param h lower bound of h(x) of node
+	 */
+	virtual void store(const Node* node, int iteration, int g, int h);
+
+private:
+	BotIDA_ConcurrentTable(const BotIDA_ConcurrentTable& table);
+	BotIDA_ConcurrentTable& operator=(const BotIDA_ConcurrentTable& table);
+};
+
+#endif /*BOTIDA_CONCURRENTTABLE_H_*/
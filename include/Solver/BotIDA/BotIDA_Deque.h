@@ -0,0 +1,100 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Lock-free deque of sub-trees of a worker of BotIDA_Parallel
+ *
+ * Work-stealing deque (Chase and Lev) of fixed capacity. Only the owner
+ * pushes and pops at the bottom (last pushed sub-tree first : depth-first
+ * order). Other workers steal at the top : the oldest sub-tree, usually the
+ * biggest one.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTIDA_DEQUE_H_
+#define BOTIDA_DEQUE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+class Zone;
+
+/**
+ * @brief More a usefull structure than a class : a sub-tree to search
+ */
+class BotIDA_Task
+{
+public :
+	/** Pusher zones from first node to first node of the sub-tree (only
+	 * the last one if the path is not needed) */
+	Zone** pusherZones;
+	Zone** boxesZones; /**< Boxes zones of the same nodes */
+	int length; /**< Number of nodes */
+	int g; /**< g(x) of first node of the sub-tree */
+	int f; /**< f(x) of first node of the sub-tree */
+
+	BotIDA_Task(int length, int g, int f);
+	~BotIDA_Task();
+};
+
+class BotIDA_Deque
+{
+protected:
+	BotIDA_Task** tasks; /**< Circular tab of tasks */
+	int capacity; /**< Length of tasks */
+	long top; /**< Index of oldest task (thieves side) */
+	long bottom; /**< Index after last pushed task (owner side) */
+
+public:
+	/**
+	 * Constructor
+	 * @param capacity max number of tasks
+	 */
+	BotIDA_Deque(int capacity);
+
+	/**
+	 * Destructor : tasks not searched are deleted
+	 */
+	~BotIDA_Deque();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/**
+	 * Test if the deque is empty (only called by owner of the deque)
+	 * @return true if there's no task (a task can be stolen after)
+	 */
+	bool isEmpty(void);
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Add a task at the bottom (only called by owner of the deque)
+	 * @param task task to add (deleted by the worker that searches it)
+	 * @return false if the deque is full (task is not added)
+	 */
+	bool push(BotIDA_Task* task);
+
+	/**
+	 * Get last pushed task (only called by owner of the deque)
+	 * @return last pushed task (NULL if empty)
+	 */
+	BotIDA_Task* pop(void);
+
+	/**
+	 * Get oldest task (called by every thread)
+	 * @return oldest task (NULL if empty or taken by another thread)
+	 */
+	BotIDA_Task* steal(void);
+
+private:
+	BotIDA_Deque(const BotIDA_Deque& deque);
+	BotIDA_Deque& operator=(const BotIDA_Deque& deque);
+};
+
+#endif /*BOTIDA_DEQUE_H_*/
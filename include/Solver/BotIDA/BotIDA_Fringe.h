@@ -0,0 +1,94 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Fringe search : IDA* iterations that don't search again nodes of
+ * previous iterations
+ *
+ * Same A* search than BotBestPushesS with a cost limit but treeNodes rejected
+ * by the cost limit stay in the tree (in fringeTable of BotA). Searched
+ * treeNodes stay in open and close hash tables : the next iteration starts
+ * from kept treeNodes under its cost limit instead of the first node.
+ *
+ * Memory grows like A* (every searched treeNode is kept) but no treeNode is
+ * searched twice.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTIDA_FRINGE_H_
+#define BOTIDA_FRINGE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BotIDA_Search.h"
+
+class BotIDA_Fringe : public BotIDA_Search
+{
+public:
+	/** Name of this solver */
+	virtual const char* SOLVER_NAME(){return "BotIDA_Fringe";}
+
+	/**
+	 * Constructor for a solver of a level
+	 * @param base main class of the game
+	 * @param level Level to be used
+	 * @param maxNodeNumber Limit number of nodes to explore by iteration
+	 * @param maxRamSize Limit max ram size to allocate
+	 * @param openTableSize size of Open Table to allocate (hashtable)
+	 * @param closeTableSize size of Close Table and fringe Table to allocate
+	 * (hashtables)
+	 * @param deadlockedBoxesSearch number of boxes to use when testing every
+	 * possible positions of deadlock
+	 * @param onlyPushNumber only keep number of pushes in Stats object.
+	 * don't generate solution Path (CPU saving for deadlocks and penalties)
+	 * @param quickSearch don't test penalties of every nodes before adding
+	 * it on the tree
+	 */
+	BotIDA_Fringe(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
+			int openTableSize, int closeTableSize,
+			int deadlockedBoxesSearch = 2, bool onlyPushNumber = false,
+			bool quickSearch = false);
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Get cost limit of next iteration : smallest f(x) of kept treeNodes.
+	 * Next iterations only search new treeNodes, so the cost limit grows by
+	 * smallest steps
+	 * @param nodeGrowth unused (growth of BotIDA_Search is only there to
+	 * avoid searching again the same treeNodes)
+	 * @return cost limit of next iteration (INT_MAX if nothing is kept)
+	 */
+	virtual int getNextCostLimit(int nodeGrowth) const;
+
+protected:
+	/**
+	 * Initialize open and close hashtables and fringe table
+	 */
+	virtual void initHashTable(void);
+
+	/**
+	 * No transposition table : searched treeNodes stay in hash tables
+	 */
+	virtual void initTranspositionTable(void);
+
+	/**
+	 * Move kept treeNodes under the cost limit to the waiting list and
+	 * search in best-first order until the waiting list is empty
+	 */
+	virtual void process(void);
+
+	/**
+	 * Move kept treeNodes under the cost limit (and not deadlocked) from
+	 * fringeTable to the waiting list. minReject gets the smallest f(x) of
+	 * other ones
+	 */
+	void releaseFringe(void);
+};
+
+#endif /*BOTIDA_FRINGE_H_*/
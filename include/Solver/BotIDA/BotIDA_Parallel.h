@@ -0,0 +1,161 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief IDA* iterations of BotIDA_Search searched by many threads
+ *
+ * Each iteration starts with the first node in the deque of the first
+ * worker (BotIDA_ParallelWorker). Workers search sub-trees depth-first and
+ * steal sub-trees of other workers when they have nothing to search. Every
+ * worker uses the same transposition table (BotIDA_ConcurrentTable) : a
+ * node already searched in this iteration by any worker is not searched
+ * again.
+ *
+ * The first worker that finds a solution cancels the others. Like
+ * BotIDA_Search, the iteration is searched again under this solution until
+ * it's the best one. Rejected children of every worker give the cost limit
+ * of the next iteration.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTIDA_PARALLEL_H_
+#define BOTIDA_PARALLEL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "BotIDA_Search.h"
+#include "BotIDA_ParallelWorker.h"
+#include "BotIDA_ConcurrentTable.h"
+
+class BotIDA_Parallel : public BotIDA_Search
+{
+protected:
+	int threadNumber; /**< Number of workers (one thread each) */
+	BotIDA_ParallelWorker** workers; /**< Every worker */
+	/** True if level of workers is initialized (by first iteration) */
+	bool workersInitialized;
+	int pendingNumber; /**< Tasks of the iteration not searched yet */
+	int idleNumber; /**< Workers without task */
+	bool cancelled; /**< True if every worker must stop its search */
+	bool limitReached; /**< True if limit of nodes is reached */
+	/** First worker that found a solution (NULL if none) */
+	BotIDA_ParallelWorker* solutionWorker;
+
+public:
+	/** Name of this solver */
+	virtual const char* SOLVER_NAME(){return "BotIDA_Parallel";}
+
+	/**
+	 * Constructor for a solver of a level
+	 * @param base main class of the game
+	 * @param level Level to be used
+	 * @param maxNodeNumber Limit number of nodes to explore by iteration
+	 * (every worker)
+	 * @param maxRamSize Limit max ram size to allocate
+	 * @param threadNumber Number of workers (one thread each)
+	 * @param deadlockedBoxesSearch number of boxes to use when testing every
+	 * possible positions of deadlock
+	 * @param onlyPushNumber only keep number of pushes in Stats object.
+	 * don't generate solution Path (CPU saving for deadlocks and penalties)
+	 * @param quickSearch don't test penalties of every nodes before adding
+	 * it on the tree
+	 */
+	BotIDA_Parallel(Base* base, Level* level, int maxNodeNumber,
+			int maxRamSize, int threadNumber, int deadlockedBoxesSearch = 2,
+			bool onlyPushNumber = false, bool quickSearch = false);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~BotIDA_Parallel();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return number of workers */
+	inline int getThreadNumber(void) const { return threadNumber; }
+	/** @Return worker of index i */
+	inline BotIDA_ParallelWorker* getWorker(int i) const { return workers[i]; }
+	/** @Return Transposition table used by every worker */
+	inline BotIDA_TranspositionTable* getTranspositionTable(void) const
+	{ return transpositionTable; }
+
+	/** @Return Tasks of the iteration not searched yet */
+	inline int getPendingNumber(void)
+	{ return __atomic_load_n(&pendingNumber, __ATOMIC_ACQUIRE); }
+	/** @Return Workers without task */
+	inline int getIdleNumber(void)
+	{ return __atomic_load_n(&idleNumber, __ATOMIC_RELAXED); }
+	/** @Return true if every worker must stop its search */
+	inline bool isCancelled(void)
+	{ return __atomic_load_n(&cancelled, __ATOMIC_ACQUIRE); }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Add a value to pendingNumber (called by every thread)
+	 * @param value 1 when a task is pushed, -1 when it's searched
+	 */
+	inline void addPendingNumber(int value)
+	{ __atomic_add_fetch(&pendingNumber, value, __ATOMIC_ACQ_REL); }
+
+	/**
+	 * Add a value to idleNumber (called by every thread)
+	 * @param value 1 when a worker has no task, -1 when it gets one
+	 */
+	inline void addIdleNumber(int value)
+	{ __atomic_add_fetch(&idleNumber, value, __ATOMIC_RELAXED); }
+
+	/**
+	 * Count a searched treeNode (called by every thread)
+	 * @return false if the search is cancelled or limit of nodes is reached
+	 */
+	bool countNode(void);
+
+	/**
+	 * Keep a solution if it's the first one and cancel the search of every
+	 * worker (called by every thread)
+	 * @param worker worker with the solution in its stats
+	 */
+	void offerSolution(BotIDA_ParallelWorker* worker);
+
+protected:
+	/**
+	 * Create the transposition table shared by every worker
+	 */
+	virtual void initTranspositionTable(void);
+
+	/**
+	 * Search the first node with every worker and get rejected children and
+	 * solution of every worker
+	 */
+	virtual void searchFirstNode(void);
+
+	/**
+	 * Initialize workers (level tables of this solver are used by every
+	 * worker)
+	 */
+	void initWorkers(void);
+
+	/**
+	 * Start a thread for each worker and wait for the end of the iteration
+	 */
+	void runWorkers(void);
+
+	/**
+	 * Get rejected children, number of nodes and solution of every worker
+	 */
+	void gatherWorkers(void);
+
+private:
+	BotIDA_Parallel(const BotIDA_Parallel& parallel);
+	BotIDA_Parallel& operator=(const BotIDA_Parallel& parallel);
+};
+
+#endif /*BOTIDA_PARALLEL_H_*/
@@ -0,0 +1,157 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief One thread of BotIDA_Parallel : depth-first search of sub-trees
+ * under the cost limit
+ *
+ * Same search than BotIDA_Search with the transposition table of
+ * BotIDA_Parallel. When another worker has nothing to search, children of
+ * the searched treeNode (except the first one) are pushed as tasks in the
+ * deque of this worker : this worker pops them when its sub-tree is
+ * searched, idle workers steal them.
+ *
+ * A task keeps its nodes from the first node (if the path is needed) :
+ * treeNodes of the worker that pushed it can be deleted before it's
+ * searched.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTIDA_PARALLELWORKER_H_
+#define BOTIDA_PARALLELWORKER_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "BotIDA_Search.h"
+#include "BotIDA_Deque.h"
+
+class BotIDA_Parallel;
+
+class BotIDA_ParallelWorker : public BotIDA_Search
+{
+protected:
+	BotIDA_Parallel* parallel; /**< Search shared by every worker */
+	int workerId; /**< Index of this worker in parallel */
+	BotIDA_Deque* deque; /**< Sub-trees pushed by this worker */
+	unsigned int random; /**< State of random choice of stolen worker */
+
+public:
+	/** Name of this solver */
+	virtual const char* SOLVER_NAME(){return "BotIDA_ParallelWorker";}
+
+	/**
+	 * Constructor for a worker of a level
+	 * @param base main class of the game
+	 * @param level Level to be used
+	 * @param parallel Search shared by every worker
+	 * @param workerId Index of this worker in parallel
+	 * @param maxNodeNumber Limit number of nodes to explore by iteration
+	 * @param maxRamSize Limit max ram size to allocate
+	 * @param deadlockedBoxesSearch number of boxes to use when testing every
+	 * possible positions of deadlock
+	 * @param onlyPushNumber only keep number of pushes in Stats object.
+	 * don't generate solution Path (CPU saving for deadlocks and penalties)
+	 * @param quickSearch don't test penalties of every nodes before adding
+	 * it on the tree
+	 */
+	BotIDA_ParallelWorker(Base* base, Level* level, BotIDA_Parallel* parallel,
+			int workerId, int maxNodeNumber, int maxRamSize,
+			int deadlockedBoxesSearch = 2, bool onlyPushNumber = false,
+			bool quickSearch = false);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~BotIDA_ParallelWorker();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return Sub-trees pushed by this worker */
+	inline BotIDA_Deque* getDeque(void) const { return deque; }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Initialize level (without first node) with the transposition table
+	 * of parallel
+	 */
+	void initWorker(void);
+
+	/**
+	 * Prepare an iteration : rejected children, number of nodes and
+	 * solution of previous one are removed
+	 * @param costLimit limit of accepted f(x)
+	 * @param iterationNumber number of the iteration (from 1)
+	 */
+	void startIteration(int costLimit, int iterationNumber);
+
+	/**
+	 * Thread function : search tasks until every task of the iteration is
+	 * searched or the search is cancelled
+	 * @param worker worker to use
+	 * @return NULL
+	 */
+	static void* run(void* worker);
+
+	/**
+	 * Create a task of a treeNode and push it in deque (only called by this
+	 * worker, or before threads are started)
+	 * @param treeNode first treeNode of the sub-tree
+	 * @return false if deque is full (no task is created)
+	 */
+	bool pushTask(TreeNode* treeNode);
+
+protected:
+	/**
+	 * No first node : every searched node comes from a task
+	 */
+	virtual void initStartingNode(void);
+
+	/**
+	 * Search own tasks (last pushed first) or stolen ones until no task is
+	 * left in the iteration
+	 */
+	virtual void process(void);
+
+	/**
+	 * Depth-first search of BotIDA_Search, stopped when the search is
+	 * cancelled (solution found or limit of nodes reached by every worker)
+	 * @param treeNode treeNode we want to search (already in the tree)
+	 * @return smallest f(x) rejected under this treeNode (INT_MAX if none)
+	 */
+	virtual int depthFirst(TreeNode* treeNode);
+
+	/**
+	 * Push children (except the first one) as tasks if a worker is idle and
+	 * deque is empty, then search other ones. f(x) of pushed children is
+	 * kept as rejected f(x) (h(x) of treeNode is not learned from them)
+	 * @param children children under the cost limit (smallest h(x) first)
+	 * @param number number of children
+	 * @return smallest f(x) rejected (or pushed) under the children
+	 */
+	virtual int searchChildren(TreeNode** children, int number);
+
+	/**
+	 * Search sub-tree of a task (if not already searched in this iteration)
+	 * @param task task to search (deleted)
+	 */
+	void searchTask(BotIDA_Task* task);
+
+	/**
+	 * Steal a task from another worker (first one is chosen randomly)
+	 * @return stolen task (NULL if none)
+	 */
+	BotIDA_Task* stealTask(void);
+
+private:
+	BotIDA_ParallelWorker(const BotIDA_ParallelWorker& worker);
+	BotIDA_ParallelWorker& operator=(const BotIDA_ParallelWorker& worker);
+};
+
+#endif /*BOTIDA_PARALLELWORKER_H_*/
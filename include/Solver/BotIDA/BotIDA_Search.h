@@ -0,0 +1,186 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Depth-first search of one IDA* iteration based on best pushes
+ * number
+ *
+ * Same costs, children and deadlocks than BotBestPushesS but only treeNodes
+ * of the actual path (and their children) are kept : a child is deleted as
+ * soon as its sub-tree is searched. Open and close hash tables are replaced
+ * by a transposition table of fixed size.
+ *
+ * The same object is used by every iteration of BotIDA : tables of the level
+ * (deadlocks, costs, penalties) and transposition table are kept, resolve is
+ * called again with a bigger cost limit.
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTIDA_SEARCH_H_
+#define BOTIDA_SEARCH_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../BotBestPushesS/BotBestPushesS.h"
+#include "BotIDA_TranspositionTable.h"
+
+class BotIDA_Search : public BotBestPushesS
+{
+protected:
+	BotIDA_TranspositionTable* transpositionTable; /**< Nodes already seen */
+	int iterationNumber; /**< Number of actual iteration (from 1) */
+	bool finished; /**< True if solution is found or first node is deadlocked */
+	int lowerBound; /**< Every solution has a bigger or equal cost */
+	/** Number of children rejected by last iteration for each f(x) :
+	 * rejectHistogram[i] for f(x) = costLimit+1+i (last cell for bigger
+	 * f(x), deadlocked children are not counted) */
+	int* rejectHistogram;
+
+public:
+	/** Name of this solver */
+	virtual const char* SOLVER_NAME(){return "BotIDA_Search";}
+	/** Number of cells of the transposition table */
+	static const int TRANSPOSITIONTABLE_SIZE = 262139;
+	/** Number of cells of rejectHistogram */
+	static const int REJECTHISTOGRAM_SIZE = 64;
+
+	/**
+	 * Constructor for a solver of a level
+	 * @param base main class of the game
+	 * @param level Level to be used
+	 * @param maxNodeNumber Limit number of nodes to explore by iteration
+	 * @param maxRamSize Limit max ram size to allocate
+	 * @param deadlockedBoxesSearch number of boxes to use when testing every
+	 * possible positions of deadlock
+	 * @param onlyPushNumber only keep number of pushes in Stats object.
+	 * don't generate solution Path (CPU saving for deadlocks and penalties)
+	 * @param quickSearch don't test penalties of every nodes before adding
+	 * it on the tree
+	 */
+	BotIDA_Search(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
+			int deadlockedBoxesSearch = 2, bool onlyPushNumber = false,
+			bool quickSearch = false);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~BotIDA_Search();
+
+	/* --------*/
+	/* Setters */
+	/* --------*/
+	/**
+	 * Set limit of accepted f(x) of next iteration
+	 * @param costLimit limit of accepted f(x)
+	 */
+	inline void setCostLimit(int costLimit) { this->costLimit = costLimit; }
+
+	/**
+	 * Set a known lower bound of solutions (cost limit of a previous search
+	 * of this level without solution + 1)
+	 * @param lowerBound every solution has a bigger or equal cost
+	 */
+	inline void setLowerBound(int lowerBound) { this->lowerBound = lowerBound; }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Start an iteration with actual cost limit (level is initialized by
+	 * first iteration). Stats of previous iteration are replaced.
+	 */
+	virtual void resolve(void);
+
+	/**
+	 * Get cost limit of next iteration from rejected children of last one :
+	 * smallest limit where rejected children under it are enough to grow
+	 * number of nodes by nodeGrowth percent (at least getMinReject)
+	 * @param nodeGrowth wanted number of nodes of next iteration (percent of
+	 * last one). 100 or less gives getMinReject (usual IDA*)
+	 * @return cost limit of next iteration (INT_MAX if nothing rejected)
+	 */
+	virtual int getNextCostLimit(int nodeGrowth) const;
+
+	/** @Return every solution has a bigger or equal cost */
+	inline int getLowerBound(void) const { return lowerBound; }
+	/** @Return Number of children rejected by last iteration for each f(x)
+	 * (see rejectHistogram) */
+	inline const int* getRejectHistogram(void) const
+	{ return rejectHistogram; }
+
+	/**
+	 * Get f(x) of the first node (level is initialized if needed)
+	 * @return f(x) of first node (INT_MAX if deadlocked)
+	 */
+	int getRootCost(void);
+
+protected:
+	/**
+	 * Initialize level, first node and transposition table (only once)
+	 */
+	void start(void);
+
+	/**
+	 * Create the transposition table used by depth-first searches
+	 */
+	virtual void initTranspositionTable(void);
+
+	/**
+	 * Search every node with f(x) under the cost limit. If the found solution
+	 * is bigger than lowerBound, search again with a cost limit under the
+	 * solution to keep the best number of pushes (if a limit is reached, the
+	 * last found solution is kept with a "not proven" message)
+	 */
+	virtual void process(void);
+
+	/**
+	 * One depth-first search from the first node with actual cost limit
+	 */
+	void search(void);
+
+	/**
+	 * Search the first node (under the cost limit) : minReject,
+	 * rejectHistogram and nodeNumber are updated, solved and stats are set
+	 * if a solution is found
+	 */
+	virtual void searchFirstNode(void);
+
+	/**
+	 * Depth-first search from a treeNode. Children are searched from
+	 * smallest to biggest h(x) and deleted after their search.
+	 * @param treeNode treeNode we want to search (already in the tree)
+	 * @return smallest f(x) rejected under this treeNode (INT_MAX if none)
+	 */
+	virtual int depthFirst(TreeNode* treeNode);
+
+	/**
+	 * Search kept children of a treeNode one after the other. Children are
+	 * deleted after their search (except treeNodes of the solution)
+	 * @param children children under the cost limit (smallest h(x) first)
+	 * @param number number of children
+	 * @return smallest f(x) rejected under the children (INT_MAX if none)
+	 */
+	virtual int searchChildren(TreeNode** children, int number);
+
+	/**
+	 * Get f(x) of a child with h(x) learned by previous iterations and test
+	 * if it's already searched in this iteration with a smaller g(x)
+	 * @param treeNode child treeNode
+	 * @param searched true if child is already searched (returned)
+	 * @return f(x) of child (INT_MAX if no solution from it)
+	 */
+	int getTranspositionF(TreeNode* treeNode, bool* searched);
+
+	/**
+	 * Count a treeNode rejected by the cost limit in minReject and
+	 * rejectHistogram
+	 * @param f f(x) of treeNode (bigger than the cost limit)
+	 */
+	void addReject(int f);
+};
+
+#endif /*BOTIDA_SEARCH_H_*/
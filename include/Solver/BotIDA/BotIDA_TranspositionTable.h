@@ -0,0 +1,123 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Transposition table of BotIDA_Search with a fixed number of items
+ *
+ * Each cell keeps one node (boxes and pusher zones), the iteration where it
+ * was last seen, its g(x) and a lower bound of its h(x). When two nodes use
+ * the same cell, the node with the smallest g(x) (biggest sub-tree) is kept
+ * (nodes of previous iterations are always replaced).
+ */
+/*----------------------------------------------*/
+
+#ifndef BOTIDA_TRANSPOSITIONTABLE_H_
+#define BOTIDA_TRANSPOSITIONTABLE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Node.h"
+
+class BotIDA_TranspositionTable
+{
+protected:
+	int length; /**< Number of cells */
+	int keyLength; /**< Number of words of a key (boxes then pusher cells) */
+	unsigned int* keys; /**< Key of each cell (keyLength words by cell) */
+	int* iterations; /**< Iteration of each cell (0 if empty) */
+	int* gValues; /**< g(x) of each cell */
+	int* hValues; /**< Lower bound of h(x) of each cell (INT_MAX if no
+					   solution from this node) */
+	int itemNumber; /**< Number of used cells */
+
+public:
+	/**
+	 * Constructor
+	 * @param length number of cells
+	 * @param numberCell number of cells of boxes and pusher zones
+	 */
+	BotIDA_TranspositionTable(int length, int numberCell);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~BotIDA_TranspositionTable();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return Number of used cells */
+	inline int getItemNumber(void) const { return itemNumber; }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Find a node in the table
+	 * @param node node we want to find
+	 * @param iteration iteration where node was seen (returned)
+	 * @param g g(x) of node when it was seen (returned)
+	 * @param h lower bound of h(x) of node (returned)
+	 * @return true if node is in the table
+	 */
+	virtual bool find(const Node* node, int* iteration, int* g, int* h);
+
+	/**
+	 * Save a node in the table (if its cell is empty, used by the same node
+	 * or by a node with a bigger g(x) or an older iteration)
+	 * @param node node we want to save
+	 * @param iteration actual iteration
+	 * @param g g(x) of node
+	 * @param h lower bound of h(x) of node
+	 */
+	virtual void store(const Node* node, int iteration, int g, int h);
+
+protected:
+	/**
+	 * Find a node in a cell
+	 * @param cell cell of node (hash function)
+	 * @param node node we want to find
+	 * @param iteration iteration where node was seen (returned)
+	 * @param g g(x) of node when it was seen (returned)
+	 * @param h lower bound of h(x) of node (returned)
+	 * @return true if node is in the cell
+	 */
+	bool findCell(int cell, const Node* node, int* iteration, int* g, int* h);
+
+	/**
+	 * Save a node in a cell (see store)
+	 * @param cell cell of node (hash function)
+	 * @param node node we want to save
+	 * @param iteration actual iteration
+	 * @param g g(x) of node
+	 * @param h lower bound of h(x) of node
+	 * @return true if cell was empty
+	 */
+	bool storeCell(int cell, const Node* node, int iteration, int g, int h);
+
+	/**
+	 * Test if a cell keeps a node (key is boxes then pusher zone)
+	 * @param cell cell to test
+	 * @param node node to test
+	 * @return true if key of the cell is the one of node
+	 */
+	bool sameKey(int cell, const Node* node) const;
+
+	/**
+	 * Hash function of key of a node
+	 * @param node node we want the cell
+	 * @return cell of the key
+	 */
+	int h(const Node* node) const;
+
+private:
+	BotIDA_TranspositionTable(const BotIDA_TranspositionTable& table);
+	BotIDA_TranspositionTable& operator=(const BotIDA_TranspositionTable& table);
+};
+
+#endif /*BOTIDA_TRANSPOSITIONTABLE_H_*/
@@ -18,53 +18,119 @@
 #include "Solver.h"
 #include "Node.h"
 #include "TreeNode.h"
+#include "HashTable.h"
+#include "VerdictCache.h"
 
 class BotGoodPushesS;
 
-class ZoneList
-{
-public:
-	Zone* zone;
-	ZoneList* next;
-	ZoneList(Zone* zone, ZoneList* next):
-		zone(zone),
-		next(next)
-	{}
-	~ZoneList()
-	{
-		delete zone;
-		if(next)
-			delete next;
-	}
-};
-
 class Deadlock
 {
 protected:
 	Base* base; /**< Main class of the game */
 	Solver* solver; /**< deadlock object belang to this solver */
 	Zone* deadlockZone; /**< Zone representation of all single positions of deadlock */
+	Zone* predicateZone; /**< Zone written by tests instead of creating a
+	temporary zone (only used between two lines of a same test) */
 	Node** deadlockNodeList; /**< List of node representations of all multiple positions of deadlock */
 	int deadlockNodeListLength; /**< number of nodes in deadlockNodeList */
-	int* deadlockTestTab; /**< Tab of current boxes positions in deadlock test */
-	int deadlockTestTabLength; /**< Length of deadlockTestTab */
+	int deadlockListBoxes; /**< Max number of boxes of searched positions of
+	deadlockNodeList */
+	int** deadlockIndexTab; /**< For each box index position, list of nodes of
+	deadlockNodeList with a box on this position */
+	int* deadlockIndexLengths; /**< Length of each list of deadlockIndexTab */
+	char* deadlockListFileName; /**< File of deadlockNodeList (NULL if the
+	list is not created) */
 	Level* emptyLevel; /**< Level with no boxes or pusher */
+	unsigned char* patternTab; /**< Verdicts of local patterns for each box
+	index position and each 3x3 boxes configuration around it (PATTERN_UNKNOWN,
+	PATTERN_FREE or PATTERN_DEADLOCK) */
+	unsigned char* patternStates; /**< Marked states of pattern search */
+	bool* goalReachTab; /**< goalReachTab[pos*goalsNumber+g] is true if a box
+	alone on box index position pos can be pushed to goal g */
+	bool* goalReachDone; /**< True if row of a box index position is computed
+	in goalReachTab (each row is computed when first used) */
+	int* matchBoxTab; /**< Goal matched with box of each box index position in
+	last matching (-1 if no box or not matched) */
+	int* matchGoalTab; /**< Box index position of box matched with each goal
+	in last matching (-1 if not matched) */
+	long long* checkCalls; /**< Number of calls of each check of deadlockedNode */
+	long long* checkHits; /**< Number of deadlocks found by each check */
+	long long* checkTimes; /**< Time spent in each check (nanoseconds) */
+	int* checkOrder; /**< Checks of deadlockedNode, best ratio of hits per
+	nanosecond first */
+	bool* checkEnabled; /**< False if check is disabled on this level */
+	mutable int checkOrderCountdown; /**< Number of calls of deadlockedNode before
+	checkOrder is sorted again */
 
 	const Level* level; /**< Initial level we want to solve */
 	const Zone* goalZone; /**< Zone representation of all goals in this level */
 	const int* zoneToLevelPos; /**< translation table between new positions in zone and old positions in level */
 	const int zoneToLevelPosLength; /**< Length of translation table */
 	const int* levelToZonePos; /**< translation table between old positions in level and new positions in zone */
+	const int* zoneToBoxPos; /**< translation table between positions in zone and positions in box index space (-1 if dead square) */
+	const int* boxToZonePos; /**< translation table between positions in box index space and positions in zone */
+	const int boxToZonePosLength; /**< Length of box index space */
 
 
 public:
-	/** Maximum junctions of simple zones to assemblate before testing them
-	 * (-1 = +inf) : zone made by 2 junctions, 3 junctions, ... */
-	static const int DEADLOCKEDZONE_MAXLEVELOFJUNCTIONS = -1;
-	/** Maximum number of zones to create by assembling junctions of zones) */
-	static const int DEADLOCKEDZONE_MAXZONESTOCREATE = 10000;
+	/** Check of a box on a deadlock cell (see deadlockedCorner) */
+	static const int CHECK_CORNER = 0;
+	/** Check of local patterns (see deadlockedLastMove) */
+	static const int CHECK_LASTMOVE = 1;
+	/** Check of frozen boxes (see deadlockedFrozen) */
+	static const int CHECK_FROZEN = 2;
+	/** Check of deadlockNodeList (see deadlockedList) */
+	static const int CHECK_LIST = 3;
+	/** Check of boxes and goals matching (see deadlockedMatching) */
+	static const int CHECK_MATCHING = 4;
+	/** Check of corrals and blocked zones (see deadlockedZone) */
+	static const int CHECK_ZONE = 5;
+	/** Number of checks of deadlockedNode */
+	static const int CHECK_NUMBER = 6;
+	/** Number of calls of deadlockedNode between two sorts of checks */
+	static const int CHECK_ORDER_PERIOD = 1000;
+	/** Number of calls without any deadlock found before a check is disabled
+	 * on this level */
+	static const int CHECK_DISABLE_CALLS = 20000;
+	/** Tests of a node are made on every box and not only on last pushed box
+	 * (debug : every node is fully validated) */
+	static const bool DEADLOCK_FULLTEST = false;
 	/** number of recursive iterations used to test a blocked zone */
 	static const int BLOCKEDZONE_DEEPNESS = 10;
+	/** Maximum number of nodes created to test if a corral is deadlocked */
+	static const int CORRAL_MAXNODES = 1000;
+	/** Size of hashtable used to store nodes of a corral search */
+	static const int CORRAL_HASHTABLE_SIZE = 53;
+	/** Size of hashtable of deadlock verdicts cache */
+	static const int VERDICTCACHE_SIZE = 100003;
+	/** Maximum number of verdicts kept in the cache */
+	static const int VERDICTCACHE_MAXITEMS = 100000;
+	/** Key of a verdict from a bounded corral search */
+	static const int VERDICTKEY_CORRAL = 1;
+	/** Key of a verdict from a blocked zone test */
+	static const int VERDICTKEY_BLOCKEDZONE = 2;
+	/** Version of the format and rules of deadlockNodeList files (files of
+	 * other versions are created again) */
+	static const int DEADLOCKLIST_FILEVERSION = 2;
+	/** Max number of boxes of positions searched for deadlockNodeList */
+	static const int DEADLOCKLIST_MAXBOXES = 3;
+	/** Maximum number of nodes created to prove a position of
+	 * deadlockNodeList (bigger searches are considered as not deadlocked) */
+	static const int DEADLOCKLIST_MAXNODES = 300;
+	/** number of recursive iterations used to test a frozen box (boxes
+	 * further from the last pushed box are considered as not frozen) */
+	static const int FROZENBOX_DEEPNESS = 10;
+
+	/** Local pattern (3x3 boxes configuration) is not tested yet */
+	static const unsigned char PATTERN_UNKNOWN = 0;
+	/** Local pattern could be solved in its window */
+	static const unsigned char PATTERN_FREE = 1;
+	/** Local pattern can't be solved in its window */
+	static const unsigned char PATTERN_DEADLOCK = 2;
+	/** Number of boxes configurations around a position (8 neighbours) */
+	static const int PATTERN_NUMBER = 256;
+	/** Width of the window (walls and goals) used to test a pattern */
+	static const int PATTERN_WINDOW = 5;
 
 	/**
 	 * Constructor
@@ -87,6 +153,14 @@ public:
 	inline Node** getDeadlockNodeList(void) const { return deadlockNodeList; }
 	/** @Return level with no boxes or pusher */
 	inline Level* getEmptyLevel(void) const { return emptyLevel; }
+	/** @Return number of calls of each check (CHECK_NUMBER cells) */
+	inline const long long* getCheckCalls(void) const { return checkCalls; }
+	/** @Return number of deadlocks found by each check */
+	inline const long long* getCheckHits(void) const { return checkHits; }
+	/** @Return time spent in each check (nanoseconds) */
+	inline const long long* getCheckTimes(void) const { return checkTimes; }
+	/** @Return false for each disabled check */
+	inline const bool* getCheckEnabled(void) const { return checkEnabled; }
 
 	/* --------*/
 	/* Setters */
@@ -98,14 +172,37 @@ public:
 	/* -------*/
 
 	/**
-	 * Test if a TreeNode is a deadlocked node
+	 * Test if a TreeNode is a deadlocked node. Checks are made in checkOrder
+	 * and each call is measured. Checks that never found any deadlock on
+	 * this level after CHECK_DISABLE_CALLS calls are not made anymore (every
+	 * check is made on first node and with DEADLOCK_FULLTEST).
 	 * @param treenode treenode to be tested
 	 * @return true if this node is a deadlock, false if not
 	 */
 	bool deadlockedNode(TreeNode* treenode) const;
 
 	/**
-	 * Test if last move made a square deadlock or a Z deadlock
+	 * Test a push before its node is created : checks of deadlockedNode that
+	 * only read boxes (corner, pattern, frozen) are made on pushed box if
+	 * they are enabled on this level. Checks are not measured.
+	 * @param boxesZone boxes after the push
+	 * @param posBox level representation of pushed box position
+	 * @return true if the push makes a deadlock, false if not known
+	 */
+	bool deadlockedPush(const Zone* boxesZone, int posBox) const;
+
+	/**
+	 * Get name of a check of deadlockedNode
+	 * @param check check (CHECK_CORNER, CHECK_LASTMOVE, ...)
+	 * @return name of the check
+	 */
+	static const char* getCheckName(int check);
+
+	/**
+	 * Test if last move made a local deadlock. Boxes around the box (3x3) are
+	 * read as a bitmask and looked up in the pattern table of this position.
+	 * Every pattern (square, Z, ...) is proven once by an exhaustive search
+	 * of pushes in a 5x5 window of walls and goals around the position.
 	 * square deadlock :
 	 * ######
 	 * #    #
@@ -128,32 +225,112 @@ public:
 	bool deadlockedLastMove(const TreeNode* treenode, int posBox=-2) const;
 
 	/**
-	 * Test if a box is on a deadlock cell (corner or deadlock lines)
+	 * Test if last move froze a box which is not on a goal. A box is frozen
+	 * when it can't be pushed horizontally nor vertically because it is
+	 * blocked by walls, by two deadlock cells or by other frozen boxes.
+	 * Only boxes around the last pushed box are analyzed.
+	 * #####   #####
+	 * #   #   #  O#
+	 * # OO#   # OO#
+	 * #  O#   #   #
+	 * #   #   #####
+	 * #####
+	 * @param treenode treenode to be tested
+	 * @param posBox level representation of box position we want to test. If
+	 * -2 we'll test last moved box
+	 * @return true if this node is a deadlock, false if not
+	 */
+	bool deadlockedFrozen(const TreeNode* treenode, int posBox=-2) const;
+
+	/**
+	 * Test if boxes can't be assigned to distinct goals they can reach alone.
+	 * Last matching between boxes and goals is repaired : boxes that moved
+	 * lose their goal and an augmenting path is searched for each of them.
+	 * @param treenode treenode to be tested
+	 * @return true if this node is a deadlock, false if not
+	 */
+	bool deadlockedMatching(const TreeNode* treenode) const;
+
+	/**
+	 * Test if boxes of the node include a position of deadlockNodeList with
+	 * pusher region of the node included in pusher region of the position.
+	 * Only positions with the last pushed box are tested (every position on
+	 * first node).
+	 * @param treenode treenode to be tested
+	 * @return true if this node is a deadlock, false if not
+	 */
+	bool deadlockedList(const TreeNode* treenode) const;
+
+	/**
+	 * Search if some boxes are deadlocked alone, for each region of pusher
+	 * around them. Deadlocked positions not already catched by others tests
+	 * are added to deadlockNodeList.
+	 * @param tab zone positions of boxes
+	 * @param tabLength number of boxes
+	 */
+	void deadlockListTest(int* tab, int tabLength);
+
+	/**
+	 * Save deadlockNodeList in its binary file with goals of level, dead
+	 * squares and limits of search (nothing is saved if the list is not
+	 * created)
+	 */
+	void saveDeadlockList() const;
+
+	/**
+	 * Test if a box is on a deadlock cell (corner or deadlock lines). Only
+	 * last pushed box is tested (every box on first node).
 	 * @param treenode treenode to be tested
 	 * @return true if this node is a deadlock, false if not
 	 */
 	bool deadlockedCorner(const TreeNode* treenode) const;
 
 	/**
-	 * Test if any deadlocked zone exists. A deadlocked zone is a zone with
-	 * boxes or walls all around and, every box you push will create a deadlock.
+	 * Test if any deadlocked corral exists. A corral is a zone the pusher
+	 * can't reach, surrounded by boxes and walls. Each corral around last
+	 * pushed box is searched alone (no test on first node). A corral
+	 * without goal is also joined, layer after layer, with corrals without
+	 * goal sharing its boxes and each of these zones is tested as a blocked
+	 * zone.
 	 * @param treenode treenode to be tested
-	 * @param maxN Maximum number of zones to join to make the high level zone
-	 * to test. If maxN = -1, then we'll use the maximum number of junctions we
-	 * could
 	 * @return true if this node is a deadlock, false if not
 	 */
-	bool deadlockedZone(TreeNode* treenode, int maxN) const;
+	bool deadlockedZone(TreeNode* treenode) const;
+
+	/**
+	 * Find the PI-corral of a node with the less boxes. In a PI-corral, pusher
+	 * can reach every box around the corral and every possible push of these
+	 * boxes is a push into the corral. If a PI-corral is not solved, pushes
+	 * of its boxes are the only pushes to be tried.
+	 * @param node node to be analyzed
+	 * @return zone with boxes of the PI-corral, NULL if no PI-corral
+	 */
+	Zone* createPICorralZone(const Node* node) const;
 
 protected:
 	/**
 	 * Test if there is a simple deadlock on the treenode.
-	 * A simple deadlock is a deadlock without recursivity
+	 * A simple deadlock is a deadlock without recursivity. Only last pushed
+	 * box is tested, except on first node or with DEADLOCK_FULLTEST.
 	 * @param treenode treenode to be tested
 	 * @return true if this node is a deadlock, false if not
 	 */
 	bool simpleDeadlock(TreeNode* treenode) const;
 
+	/**
+	 * Make a check of deadlockedNode and update its counters
+	 * @param check check (CHECK_CORNER, CHECK_LASTMOVE, ...)
+	 * @param treenode treenode to be tested
+	 * @return true if this node is a deadlock, false if not
+	 */
+	bool measuredCheck(int check, TreeNode* treenode) const;
+
+	/**
+	 * Sort checkOrder by ratio of hits per nanosecond and disable checks
+	 * without any hit after CHECK_DISABLE_CALLS calls
+	 */
+	void sortChecks(void) const;
+
 	/**
 	 * Test if there is a complex deadlock on the treenode.
 	 * A complex deadlock is a deadlock with recursivity
@@ -162,6 +339,72 @@ protected:
 	 */
 	bool complexDeadlock(TreeNode* treenode) const;
 
+	/**
+	 * Test if a box is frozen. Boxes already being tested (marked in
+	 * wallZone) are considered as walls so recursivity always ends.
+	 * @param posBox level representation of box position
+	 * @param boxesZone boxes positions in this state of level
+	 * @param wallZone boxes currently tested (considered as walls)
+	 * @param offGoal set to true if this box is frozen and if itself or one of
+	 * the boxes freezing it is not on a goal
+	 * @param n remaining number of recursive iterations
+	 * @return true if this box is frozen, false if not
+	 */
+	bool isFrozenBox(int posBox, const Zone* boxesZone, Zone* wallZone,
+			bool* offGoal, int n) const;
+
+	/**
+	 * Test if a box is blocked on one axis (horizontal or vertical)
+	 * @param posBox level representation of box position
+	 * @param step 1 for horizontal axis, number of columns for vertical axis
+	 * @param boxesZone boxes positions in this state of level
+	 * @param wallZone boxes currently tested (considered as walls)
+	 * @param offGoal set to true if a box used to block this one is frozen
+	 * and not on a goal
+	 * @param n remaining number of recursive iterations
+	 * @return true if box can't move on this axis, false if not
+	 */
+	bool isFrozenAxis(int posBox, int step, const Zone* boxesZone,
+			Zone* wallZone, bool* offGoal, int n) const;
+
+	/**
+	 * Get the 3x3 boxes configuration around a box
+	 * @param boxesZone boxes positions in this state of level
+	 * @param posBox level representation of box position
+	 * @return bitmask of the 8 neighbours (up-left, up, up-right, left, right,
+	 * down-left, down, down-right), 1 when the neighbour is a box
+	 */
+	int createPatternMask(const Zone* boxesZone, int posBox) const;
+
+	/**
+	 * Test if a local pattern is deadlocked. The verdict is searched only the
+	 * first time and then kept in patternTab.
+	 * @param posBox level representation of box position
+	 * @param mask boxes configuration around the box (see createPatternMask)
+	 * @return true if this pattern is a deadlock, false if not
+	 */
+	bool isDeadlockedPattern(int posBox, int mask) const;
+
+	/**
+	 * Exhaustive search of pushes in the window around a box. Cells outside
+	 * the 3x3 boxes square are considered free and connected, and a box
+	 * pushed there is removed. Pattern is deadlocked if no state with every
+	 * remaining box on a goal can be reached.
+	 * @param posBox level representation of box position
+	 * @param mask boxes configuration around the box (see createPatternMask)
+	 * @return true if this pattern is a deadlock, false if not
+	 */
+	bool searchPattern(int posBox, int mask) const;
+
+	/**
+	 * Get the pusher region of a cell in a pattern window
+	 * @param window cells of the window (-1 for walls)
+	 * @param boxes boxes of the window (one bit per cell)
+	 * @param cell cell of the window where pusher is
+	 * @return bitmask of the cells reachable by pusher
+	 */
+	int createPatternRegion(const int* window, int boxes, int cell) const;
+
 	/**
 	 * Create a tab containing list of all single empty zones except empty
 	 * zones with pusher position
@@ -182,35 +425,6 @@ protected:
 	 */
 	int* createNeighboursTab(Zone* boxesZone, int pos) const;
 
-	/**
-	 * Create a chained list with every usefull zone of size 1 and put it on the
-	 * first cell of received tab of zone lists
-	 * @param neiTab list of empty positions
-	 * @param boxesZone list of boxes position of this state
-	 * @param pusherZone list of pusher position of this state
-	 * @param zoneListTab Tab of chained list of zones (now empty because we
-	 * want to fill the first cell here (the one with 1 size zone))
-	 * @return modified zoneListTab with first cell of tab filled with a chained
-	 * list full of zone of size 1
-	 */
-	ZoneList** createInitialZoneListTab(int* neiTab, Zone* boxesZone,
-			Zone* pusherZone, ZoneList** zoneListTab) const;
-
-	/**
-	 * Create modified zoneListTab with "size" number of cell of tab filled
-	 * with a chained list full of zones of "size" number of junctions
-	 * @param zoneListTab Tab of chained list of zones (size-1 first cells must
-	 * be filled to use this function)
-	 * @param zoneTab list of every empty zones except the ones with pusher
-	 * @param size size of junctions of zones we want to create (must be >=2)
-	 * @param maxZoneToTest total number of zones to create. If number reached,
-	 * we stop to create new zones because it will be excessive
-	 * @return modified zoneListTab with "size" number of cell of tab filled
-	 * with a chained list full of zones of "size" number of junctions
-	 */
-	ZoneList** createIZoneListTab(ZoneList** zoneListTab, Zone** zoneTab,
-			int size, int* maxZoneToTest) const;
-
 	/**
 	 * Test if a zone is blocked. A zone is blocked when pusher is not on the
 	 * zone, zone doesn't have any goal and all boxes of the zone are only
@@ -246,6 +460,115 @@ protected:
 	 */
 	bool isZoneBlockedBox(int boxPos, TreeNode* treenode,
 			const Zone* testZone, int n) const;
+
+	/**
+	 * Search an augmenting path from a box to a free goal in the graph of
+	 * reachable goals and apply it to the matching.
+	 * @param pos box index position of an unmatched box
+	 * @param visitedGoal goals already visited by this search
+	 * @return true if box is now matched, false if not
+	 */
+	bool augmentMatching(int pos, bool* visitedGoal) const;
+
+	/**
+	 * Compute row of a box index position in goalReachTab : with cost table
+	 * of the solver if it has one, with pushes of a box alone if not.
+	 * @param pos box index position of the box
+	 */
+	void initGoalReachRow(int pos) const;
+
+	/**
+	 * Test if a zone is blocked (see isBlockedZone) with BLOCKEDZONE_DEEPNESS
+	 * iterations. Verdict is read from the verdicts cache of the solver if
+	 * the same zone was already tested with the same boxes and pusher zone.
+	 * @param zone zone to test
+	 * @param treenode treenode where the zone is
+	 * @return true if the zone is blocked, false if not
+	 */
+	bool isCachedBlockedZone(const Zone* zone, TreeNode* treenode) const;
+
+	/**
+	 * Create the key of a verdict in the verdicts cache : kind of test,
+	 * pusher flag and words of every given zone.
+	 * @param kind kind of test (VERDICTKEY_CORRAL, VERDICTKEY_BLOCKEDZONE)
+	 * @param pusherOutside true if pusher is not in the tested zone
+	 * @param zone1 first zone of the key
+	 * @param zone2 second zone of the key
+	 * @param zone3 third zone of the key (NULL if not used)
+	 * @param keyLength returned number of words of the key
+	 * @return key (to be freed)
+	 */
+	unsigned int* createVerdictKey(int kind, bool pusherOutside,
+			const Zone* zone1, const Zone* zone2, const Zone* zone3,
+			int* keyLength) const;
+
+	/**
+	 * Search every pushes of the boxes of a node (breadth-first). Search is
+	 * stopped as soon as every box is on a goal or pusher reaches exitZone.
+	 * @param startNode node to start from (not modified)
+	 * @param exitZone zone that opens the position when pusher reaches it
+	 * (NULL if only goals count)
+	 * @param maxNodes maximum number of nodes created (search is stopped and
+	 * not deadlocked when reached)
+	 * @return true if every reachable position was searched without success
+	 */
+	bool searchBoxes(const Node* startNode, const Zone* exitZone,
+			int maxNodes) const;
+
+	/**
+	 * Load deadlockNodeList from its file or create it with positions of 2
+	 * to numberOfBoxes boxes, and save it
+	 * @param numberOfBoxes max number of boxes of searched positions
+	 */
+	void initDeadlockList(int numberOfBoxes);
+
+	/**
+	 * Search every connected positions (8 neighbours) of tabLength boxes.
+	 * First boxes are given and others are added with bigger box index
+	 * positions.
+	 * @param tab box index positions (numberOfBoxes cells)
+	 * @param tabLength number of boxes already in tab
+	 * @param numberOfBoxes number of boxes of searched positions
+	 */
+	void createDeadlockList(int* tab, int tabLength, int numberOfBoxes);
+
+	/**
+	 * Add a deadlocked position to deadlockNodeList and to its index
+	 * @param node deadlocked position (boxes and pusher region)
+	 */
+	void addToDeadlockList(Node* node);
+
+	/**
+	 * Load deadlockNodeList from a binary file. Nothing is loaded if the file
+	 * was made with other goals (test levels of same level), other dead
+	 * squares, other limits of search or another DEADLOCKLIST_FILEVERSION.
+	 * @param fileName name of file
+	 */
+	void loadDeadlockList(const char* fileName);
+
+	/**
+	 * Test if a corral is deadlocked. Every box not around or in the corral
+	 * is removed and we search every pushes of these boxes. The corral is
+	 * deadlocked if we can't put them all on goals or open the corral.
+	 * Search is stopped (not deadlocked) after CORRAL_MAXNODES nodes.
+	 * Verdict only depends on the corral, its boxes and the region of the
+	 * pusher, so it's kept in the verdicts cache of the solver.
+	 * @param corralZone corral to test (with boxes around it)
+	 * @param node node where the corral is
+	 * @return true if this corral is deadlocked, false if not
+	 */
+	bool isDeadlockedCorral(const Zone* corralZone, const Node* node) const;
+
+	/**
+	 * Test if a corral is a PI-corral that is not solved. Pushes of boxes
+	 * not into the corral must be impossible until a box of the corral moves
+	 * (wall, box of the corral or position in the corral) and pushes into
+	 * the corral must be possible now.
+	 * @param corralZone corral to test (with boxes around it)
+	 * @param node node where the corral is
+	 * @return true if this corral is a PI-corral, false if not
+	 */
+	bool isPICorral(const Zone* corralZone, const Node* node) const;
 };
 
 #endif /*DEADLOCK_H_*/
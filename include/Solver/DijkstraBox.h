@@ -14,6 +14,18 @@
  * represented by 4 nodes : left, up, right and down. Value in each node
  * means "I can push this box in there by pushing it from left/up/right/down
  * with a total of VALUE pushes"
+ *
+ * Each solver owns one DijkstraBox reused for every box (see setBox). Every
+ * push costs 1 so dijkstra is a breadth-first search : waiting nodes are
+ * kept in a preallocated queue and values of a previous search are ignored
+ * with a search number (tables are never initialized again). Positions the
+ * pusher can reach around the box are computed once by box position.
+ *
+ * Results of resolveGoals can be kept for each box position : search only
+ * depends on boxes of positions it tested and on first pusher positions
+ * around the box. A result is used again while those are the same.
+ * KEPT_GOALS_NUMBER results are kept for each box position (results of
+ * nodes processed one after another are often different).
  */
 /*----------------------------------------------*/
 
@@ -22,63 +34,72 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 #include "Solver.h"
 #include "Node.h"
 
-class CellList
-{
-public:
-	int pos;
-	int dir;
-	int value;
-	CellList* next;
-	CellList(int pos, int dir, int value, CellList* next):
-		pos(pos),
-		dir(dir),
-		value(value),
-		next(next)
-	{}
-	~CellList()
-	{
-		if(next)
-			delete next;
-	}
-};
-
 class DijkstraBox
 {
 protected:
 	/**
 	 * actual dijkstra cost Table : getPos(x,y,VAR) is value of a cell where
 	 * VAR is RIGHT, LEFT, UP or DOWN and (x,y) is position of a cell of
-	 * this level.
+	 * this level. A value is only valid if its searchTable value is egal
+	 * to searchNumber.
 	 */
 	int* dTable;
+	int* searchTable; /**< Search number of each value of dTable */
+	int searchNumber; /**< Number of actual search */
 	const Solver* solver; /**< Solver w're using right now */
 	Node* node; /**< current node we want to apply dijkstra to */
+	const Zone* boxesZone; /**< boxes zone of node */
+	const int* lToZPos; /**< Link between real positions and zone positions */
 	int boxPos; /**< current box position we want to test */
 	int nCols; /**< number of columns in this level */
+	int nPos; /**< number of positions in this level */
 
-	CellList* firstCell; /**< First cell of waiting cells chainedList */
-	CellList* lastCell; /**< Last cell of waiting cells chainedList */
+	int* queue; /**< waiting nodes (pos*4+dir) of the search */
+	int queueStart; /**< Index of first waiting node in queue */
+	int queueEnd; /**< Index after last waiting node in queue */
+
+	/**
+	 * Regions of neighbours of a box position : pusher behind neighbour i
+	 * can reach neighbour j if groupTab[pos*4+i] == groupTab[pos*4+j]
+	 * (-1 if neighbour is not free)
+	 */
+	int* groupTab;
+	int* groupSearchTable; /**< Search number of groups of each position */
+	int* floodQueue; /**< Waiting positions when looking for regions */
+	int* floodTable; /**< Flood number of each position reached */
+	int floodNumber; /**< Number of actual flood */
+
+	Zone* testedZone; /**< If not NULL, positions tested by search are set */
+	Zone** goalsTested; /**< For each kept result : positions tested by
+							 resolveGoals (NULL if none) */
+	Zone** goalsBoxes; /**< For each kept result : boxes zone */
+	int* goalsStart; /**< For each kept result : first pusher positions
+						  around the box */
+	int* goalsValues; /**< For each kept result : values of goals */
+	int* goalsLastPositions; /**< For each kept result : last push positions
+								  of goals */
+	int* goalsNext; /**< For each box zone position : next replaced result */
+	int goalsHitNumber; /**< Number of resolveGoals results used again */
+	int goalsMissNumber; /**< Number of computed resolveGoals results */
 
 public:
 	static const int LEFT  = 0; /**< index of left node */
 	static const int RIGHT = 1; /**< index of right node */
 	static const int UP    = 2; /**< index of up node */
 	static const int DOWN  = 3; /**< index of down node */
+	static const int KEPT_GOALS_NUMBER = 4; /**< Number of resolveGoals
+												 results kept by box position */
 
 	/**
-	 * Constructor of a new table where we'll apply dijkstra later
-	 * This constructor will let you use a node where a specific
-	 * starting pusherZone is defined
+	 * Constructor of tables reused by every search of a solver
 	 * @param solver Solver we're using right now
-	 * @param node current node we want to test
-	 * @param boxPos box position (level representation) we want to move
-	 * to goals
 	 */
-	DijkstraBox(const Solver* solver, Node* node, int boxPos);
+	DijkstraBox(const Solver* solver);
 
 	/**
 	 * Destructor of the table
@@ -90,6 +111,22 @@ public:
 	/* --------*/
 	/** @Return Solver we're using right now */
 	inline const Solver* getSolver(void) const { return solver; }
+	/** @Return Number of resolveGoals results used again */
+	inline int getGoalsHitNumber(void) const { return goalsHitNumber; }
+	/** @Return Number of computed resolveGoals results */
+	inline int getGoalsMissNumber(void) const { return goalsMissNumber; }
+
+	/* --------*/
+	/* Setters */
+	/* --------*/
+	/**
+	 * Start a new search : values of previous search are forgotten.
+	 * Starting pusherZone of node is used for first pushes.
+	 * @param node current node we want to test
+	 * @param boxPos box position (level representation) we want to move
+	 * to goals
+	 */
+	void setBox(Node* node, int boxPos);
 
 	/* -------*/
 	/* Others */
@@ -99,54 +136,50 @@ public:
 	 * @param x x position in level
 	 * @param y y position in level
 	 * @param dir must be RIGHT/LEFT/UP/DOWN
-	 * @return value of a position in the table
+	 * @return value of a position in the table (-1 for a wall or another
+	 * box, INT_MAX if not reached)
 	 */
-	inline int getPos(int x, int y, int dir) const
+	inline int getPos(int x, int y, int dir)
 	{
-		return dTable[x*nCols*4 + y*4 + dir];
+		return getPos(x*nCols + y, dir);
 	}
 
 	/**
 	 * Return value of a position in the table
 	 * @param pos pos position in this level
 	 * @param dir must be RIGHT/LEFT/UP/DOWN
-	 * @return value of a position in the table
+	 * @return value of a position in the table (-1 for a wall or another
+	 * box, INT_MAX if not reached)
 	 */
-	inline int getPos(int pos, int dir) const
+	inline int getPos(int pos, int dir)
 	{
+		if(isBlocked(pos))
+			return -1;
+		if(searchTable[pos*4 + dir] != searchNumber)
+			return INT_MAX;
 		return dTable[pos*4 + dir];
 	}
 
 	/**
-	 * Assign value of a position in the table
-	 * @param x x position in level
-	 * @param y y position in level
-	 * @param dir must be RIGHT/LEFT/UP/DOWN
-	 */
-	inline void setPos(int x, int y, int dir, int value) const
-	{
-		dTable[x*nCols*4 + y*4 + dir] = value;
-	}
-
-	/**
-	 * Assign value of a position in the table
-	 * @param pos pos position in this level
-	 * @param dir must be RIGHT/LEFT/UP/DOWN
-	 * @return value of a position in the table
+	 * compute dijkstra and return value of every goal positions
+	 * @param pLastPushPosition allocated pointer with numOfGoals positions
+	 * that will be filled with positions of pusher when making last push
+	 * of each goal
+	 * @return tab of values of goals positions (level representation)
 	 */
-	inline void setPos(int pos, int dir, int value) const
-	{
-		dTable[pos*4 + dir] = value;
-	}
+	int* resolveGoals(int* pLastPushPosition);
 
 	/**
-	 * compute dijkstra and return value of every goal positions
+	 * Same as resolveGoals but use last result computed for box position if
+	 * boxes it tested and first pusher positions didn't change.
+	 * BE CAREFULL : table of values is not computed if a result is used again
+	 * (don't use listMovesToPosition after)
 	 * @param pLastPushPosition allocated pointer with numOfGoals positions
 	 * that will be filled with positions of pusher when making last push
 	 * of each goal
 	 * @return tab of values of goals positions (level representation)
 	 */
-	int* resolveGoals(int* pLastPushPosition);
+	int* resolveKeptGoals(int* pLastPushPosition);
 
 	/**
 	 * compute dijkstra and return value of every positions
@@ -167,12 +200,60 @@ public:
 
 protected:
 	/**
-	 * recursive call of dijkstra
+	 * Test if a position can't be used by the box : wall or another box
+	 * (position is marked in testedZone if any)
+	 * @param pos position in level
+	 * @return true if box can't be there
+	 */
+	inline bool isBlocked(int pos)
+	{
+		int zonePos = lToZPos[pos];
+		if(zonePos == -1)
+			return true;
+		if(testedZone)
+			testedZone->write1ToPos(zonePos);
+		return pos != boxPos && boxesZone->readPos(zonePos) == 1;
+	}
+
+	/**
+	 * Breadth-first search of every box positions from boxPos
+	 */
+	void search(void);
+
+	/**
+	 * Get neighbours of boxPos where pusher can be before first push
+	 * @return bit i is 1 if pusher can push the box from neighbour i
+	 */
+	int getStartNeighbours(void) const;
+
+	/**
+	 * Allocate tables of kept resolveGoals results
+	 */
+	void initKeptGoals(void);
+
+	/**
+	 * Add a waiting node if it's not reached yet
 	 * @param posBox position of box in level
 	 * @param dir dir must be RIGHT/LEFT/UP/DOWN
 	 * @param value value we want to assign at this position
 	 */
-	void dijkstraRec(int posBox, int dir, int value);
+	void addToQueue(int posBox, int dir, int value);
+
+	/**
+	 * Compute (if not done in this search) regions of neighbours of a box
+	 * position when box is on it
+	 * @param posBox position of box in level
+	 * @return regions of the 4 neighbours (see groupTab)
+	 */
+	const int* getGroups(int posBox);
+
+	/**
+	 * Test if free neighbours of a position are connected by the 8 positions
+	 * around
+	 * @param posBox position of box in level
+	 * @return true if they are connected
+	 */
+	bool isLocallyConnected(int posBox);
 
 	/**
 	 * Debug function to print actual level state
@@ -0,0 +1,179 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Goal room of a level and order to fill its goals
+ *
+ * A goal room is a part of the level with every goals and only one entrance
+ * (a position between two walls that separates it from other positions and
+ * from at least one box of the level). Order to fill the goals is found once
+ * by a retrograde search : starting with every goal filled, boxes are pulled
+ * out of the room one after another (nearest to entrance first). Goals are
+ * filled in reverse order.
+ *
+ * Boxes on the first goals of the order (packed boxes) are not moved again.
+ * Room and order are only searched for solvers that don't need the best
+ * solution (see Solver::usesPackingOrder).
+ */
+/*----------------------------------------------*/
+
+#ifndef GOALROOM_H_
+#define GOALROOM_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "Solver.h"
+#include "Zone.h"
+
+class GoalRoom
+{
+protected:
+	const Solver* solver; /**< Solver w're using right now */
+	int length; /**< Number of positions of zones */
+	int nCols; /**< number of columns in this level */
+	Zone* roomZone; /**< Positions of the room (NULL if no goal room) */
+	int entrance; /**< Zone position of the entrance (-1 if no goal room) */
+	int* packingOrder; /**< Zone positions of goals in filling order */
+	int packingLength; /**< Number of goals of packingOrder (0 if no order) */
+	int* packingRank; /**< For each zone position : rank in packingOrder
+						   (-1 if not a goal of the order) */
+
+	int* floodQueue; /**< Waiting positions of floods */
+	int* floodTable; /**< Flood number of each position reached */
+	int floodNumber; /**< Number of actual flood */
+	int* pullQueue; /**< Waiting states (pos*4+dir) of pull searches */
+	int* pullTable; /**< Distance of each state reached by a pull search */
+	int* pullSearchTable; /**< Search number of each state of pullTable */
+	int pullNumber; /**< Number of actual pull search */
+
+public:
+	/**
+	 * Constructor : find goal room and order to fill its goals (if the
+	 * solver uses them)
+	 * @param solver Solver we're using right now (zone tables initialized)
+	 */
+	GoalRoom(const Solver* solver);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~GoalRoom();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return true if a goal room and an order to fill it are found */
+	inline bool isFound(void) const { return packingLength > 0; }
+	/** @Return Positions of the room (NULL if no goal room) */
+	inline const Zone* getRoomZone(void) const { return roomZone; }
+	/** @Return Zone position of the entrance (-1 if no goal room) */
+	inline int getEntrance(void) const { return entrance; }
+	/** @Return Zone positions of goals in filling order */
+	inline const int* getPackingOrder(void) const { return packingOrder; }
+	/** @Return Number of goals of filling order (0 if not found) */
+	inline int getPackingLength(void) const { return packingLength; }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Get number of packed boxes : first goals of the order with a box when
+	 * the room has no other box
+	 * @param boxesZone boxes of a node
+	 * @return number of first goals of the order filled by a box (0 if order
+	 * is not followed)
+	 */
+	int getPackedNumber(const Zone* boxesZone) const;
+
+	/**
+	 * Test if a box is packed (not moved again)
+	 * @param zonePos zone position of the box
+	 * @param packedNumber number of packed boxes (see getPackedNumber)
+	 * @return true if zonePos is one of the first packedNumber goals
+	 */
+	inline bool isPacked(int zonePos, int packedNumber) const
+	{
+		return packingLength > 0 && packingRank[zonePos] != -1
+			&& packingRank[zonePos] < packedNumber;
+	}
+
+protected:
+	/**
+	 * Test if the order is followed : boxes of the room are on the first
+	 * goals of the order
+	 * @param boxesZone boxes of a node
+	 * @return number of boxes of the room, -1 if order is not followed or
+	 * there is no order
+	 */
+	int getFollowedNumber(const Zone* boxesZone) const;
+
+	/**
+	 * Find smallest part of the level with every goals and one bounded
+	 * entrance, with at least one box of the level out of it
+	 */
+	void findRoom(void);
+
+	/**
+	 * Test if a position can be an entrance : walls on both sides of a
+	 * horizontal or vertical passage
+	 * @param zonePos zone position
+	 * @return true if zonePos only has two opposite neighbours
+	 */
+	bool isBoundedPos(int zonePos) const;
+
+	/**
+	 * Test if a box of the level is out of the room of the last flood
+	 * @return true if a box (at start of the level) is not reached by the
+	 * last flood
+	 */
+	bool hasBoxOutside(void) const;
+
+	/**
+	 * Find order to fill goals of the room by pulling boxes out of it
+	 */
+	void findPackingOrder(void);
+
+	/**
+	 * Number of pulls needed to take a box out of the room (to entrance with
+	 * pusher out of the room)
+	 * @param boxes other boxes of the room
+	 * @param boxPos zone position of the box
+	 * @return number of pulls, -1 if box can't be taken out of the room
+	 */
+	int pullOut(const Zone* boxes, int boxPos);
+
+	/**
+	 * Mark every free position reached from a start position (a new flood
+	 * number is used : reached positions have floodTable == floodNumber)
+	 * @param startPos zone position where the flood starts
+	 * @param boxes positions that can't be reached (NULL if none)
+	 * @param forbiddenPos other position that can't be reached (-1 if none)
+	 * @return number of reached positions
+	 */
+	int flood(int startPos, const Zone* boxes, int forbiddenPos);
+
+	/**
+	 * Zone position next to a zone position
+	 * @param zonePos zone position
+	 * @param dir 0 for left, 1 for right, 2 for up and 3 for down
+	 * @return zone position of neighbour (-1 if it's not a zone position)
+	 */
+	inline int getNeighbour(int zonePos, int dir) const
+	{
+		static const int dx[4] = {-1, 1, 0, 0};
+		static const int dy[4] = {0, 0, -1, 1};
+		int lPos = solver->getZoneToLevelPos()[zonePos];
+		return solver->getLevelToZonePos()[lPos + dx[dir] + dy[dir]*nCols];
+	}
+
+private:
+	GoalRoom(const GoalRoom& goalRoom);
+	GoalRoom& operator=(const GoalRoom& goalRoom);
+};
+
+#endif /*GOALROOM_H_*/
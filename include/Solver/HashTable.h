@@ -89,13 +89,33 @@ public:
 	 */
 	TreeNode* getTreeNodeFromNode(const Node* node);
 
+	/**
+	 * Get a treenode pointer in hashtable from the state of a node not
+	 * created yet. Pusher zones of nodes with the same boxes are the same or
+	 * don't have any common position, so a position of pusher is enough.
+	 * @param boxesZone boxes of the node
+	 * @param pusherPos position of pusher in the node (zone representation)
+	 * @return treenode pointer to found node or NULL if node doesn't exist in
+	 * hashtable
+	 */
+	TreeNode* getTreeNodeFromState(const Zone* boxesZone, int pusherPos);
+
 protected:
 	/**
 	 * Hashing function that use a node to compute an index number for the tab
+	 * (only boxes are used, see getTreeNodeFromState)
 	 * @param node Node we want to compute
 	 * @return index number for the tab
 	 */
 	int h(const Node* node) const;
+
+	/**
+	 * Hashing function that use boxes of a node to compute an index number
+	 * for the tab
+	 * @param boxesZone boxes of the node
+	 * @return index number for the tab
+	 */
+	int h(const Zone* boxesZone) const;
 };
 
 #endif /*HASHTABLE_H_*/
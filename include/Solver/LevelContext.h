@@ -0,0 +1,90 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Analysis of a level that doesn't depend on boxes and pusher
+ *
+ * Translation tables, goals, dead squares, box index space, tunnels and cost
+ * table of a level are copied from the first solver of this level. Solvers of
+ * levels with same walls and goals (iterations of BotIDA, solvers of penalties
+ * and deadlocks tests) use them instead of computing (or loading) them again.
+ *
+ * Nothing is modified after construction : the same object can be shared by
+ * many solvers at the same time.
+ */
+/*----------------------------------------------*/
+
+#ifndef LEVELCONTEXT_H_
+#define LEVELCONTEXT_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Solver.h"
+#include "Zone.h"
+
+class LevelContext
+{
+protected:
+	int* zoneToLevelPos; /**< translation table between positions in zone and positions in level */
+	int zoneToLevelPosLength; /**< Length of translation table */
+	int* levelToZonePos; /**< translation table between positions in level and positions in zone */
+	int levelToZonePosLength; /**< Length of translation table (nRows*nCols) */
+	Zone* goalZone; /**< Zone representation of all goals */
+	int* goalsPositions; /**< zone positions of every goals */
+	int goalsNumber; /**< Number of goals */
+	Zone* deadSquareZone; /**< Positions where a box is always deadlocked */
+	int* zoneToBoxPos; /**< translation table between positions in zone and positions in box index space */
+	int* boxToZonePos; /**< translation table between positions in box index space and positions in zone */
+	int boxToZonePosLength; /**< Length of box index space */
+	bool* tunnelTab; /**< Tunnels of each zone position (see Solver) */
+	int** costTable; /**< Minimum number of pushes between every box index position and zone position (NULL if none) */
+
+public:
+	/**
+	 * Constructor : copy tables of an initialized solver
+	 * @param solver Solver with level tables initialized
+	 */
+	LevelContext(const Solver* solver);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~LevelContext();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return Translation table between zone and level */
+	inline const int* getZoneToLevelPos(void) const { return zoneToLevelPos; }
+	/** @Return Translation table length */
+	inline int getZoneToLevelPosLength(void) const { return zoneToLevelPosLength; }
+	/** @Return Translation table between level and zone */
+	inline const int* getLevelToZonePos(void) const { return levelToZonePos; }
+	/** @Return Binary representation of the goals */
+	inline const Zone* getGoalZone(void) const { return goalZone; }
+	/** @Return goal positions of every goals */
+	inline const int* getGoalsPositions(void) const { return goalsPositions; }
+	/** @Return Positions where a box is always deadlocked */
+	inline const Zone* getDeadSquareZone(void) const { return deadSquareZone; }
+	/** @Return Translation table between zone and box index space */
+	inline const int* getZoneToBoxPos(void) const { return zoneToBoxPos; }
+	/** @Return Translation table between box index space and zone */
+	inline const int* getBoxToZonePos(void) const { return boxToZonePos; }
+	/** @Return Length of box index space */
+	inline int getBoxToZonePosLength(void) const { return boxToZonePosLength; }
+	/** @Return Tunnels of each zone position */
+	inline const bool* getTunnelTab(void) const { return tunnelTab; }
+	/** @Return Cost table of the level (NULL if solver had none) */
+	inline const int* const* getCostTable(void) const { return costTable; }
+
+private:
+	LevelContext(const LevelContext& levelContext);
+	LevelContext& operator=(const LevelContext& levelContext);
+};
+
+#endif /*LEVELCONTEXT_H_*/
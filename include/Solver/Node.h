@@ -22,6 +22,8 @@
 #include <limits.h>
 #include "Solver.h"
 #include "DijkstraBox.h"
+#include "GoalRoom.h"
+#include "Push.h"
 #include "BotA/BotA_Child.h"
 
 class Node
@@ -114,17 +116,50 @@ public:
 	 */
 	Node** findChildren(void) const;
 
+	/**
+	 * Use this node to find all pushes without creating successor nodes.
+	 * Nothing is allocated.
+	 * @param pushes tab where pushes are written (at least 4 by box)
+	 * @param forbiddenZone pushes of a box to a position of this zone are
+	 * skipped (dead squares). Can be NULL.
+	 * @return number of pushes written in pushes
+	 */
+	int findPushes(Push* pushes, const Zone* forbiddenZone) const;
+
+	/**
+	 * Push the box of a push again while it's in a tunnel : pusher and box
+	 * have walls on both sides, box isn't on a goal and next position is free
+	 * (not a box nor a dead square). Box can't stop there so it's carried to
+	 * the end of the tunnel in one push of cost pushCost.
+	 * @param push push found with findPushes, modified if it enters a tunnel
+	 */
+	void applyTunnel(Push* push) const;
+
+	/**
+	 * Create successor node of a push found with findPushes
+	 * @param push push applied to this node
+	 * @return new successor node
+	 */
+	Node* createChild(const Push* push) const;
+
+	/**
+	 * Write boxes of the successor node of a push in a zone without
+	 * creating the node (tests of the push before createChild)
+	 * @param push push applied to this node
+	 * @param childBoxesZone zone where boxes are written (same length)
+	 */
+	void writeChildBoxes(const Push* push, Zone* childBoxesZone) const;
+
 	/**
 	 * Use this node to find all macro successor nodes. A macro successor node
 	 * exists if we can push a box on a goal directly, even if you have to do
 	 * many pushes of the same box to make it.
-	 * @param nodeList list of direct successor previously found with
-	 * findChildren.
-	 * @return modified nodeList added with all macro pushes.
-	 * Terminated by a NULL.
-	 * @return tab of number of pushes for all macro-pushes.
+	 * @param pushes direct pushes previously found with findPushes
+	 * @param pushNumber number of pushes in pushes
+	 * @return list of children of pushes (cost 0) followed by macro children
+	 * (cost is their number of pushes). Terminated by a NULL.
 	 */
-	Child** findMacroChildren(Node** nodeList);
+	Child** findMacroChildren(const Push* pushes, int pushNumber);
 
 	/**
 	 * This function use this node (box positions) to make the shortest way
@@ -173,6 +208,41 @@ protected:
 	 * @return tab of cost of each goal
 	 */
 	int* computeCostOfGoals(Node* node);
+
+	/**
+	 * Test if a box next to posFrom can be pushed to posTo
+	 * @param posFrom position of pusher before the push (zone representation)
+	 * @param posTo position of box after the push (zone representation)
+	 * @param forbiddenZone positions where a box can't be pushed (can be NULL)
+	 * @return true if pusher reaches posFrom and posFrom, posTo are free
+	 */
+	inline bool canPush(const int posFrom, const int posTo,
+			const Zone* forbiddenZone) const
+	{
+		return pusherZone->readPos(posFrom) == 1
+			&& boxesZone->readPos(posFrom) == 0
+			&& boxesZone->readPos(posTo) == 0
+			&& (forbiddenZone == NULL || forbiddenZone->readPos(posTo) == 0);
+	}
+
+	/**
+	 * Fill a push in
+	 * @param push push to be filled
+	 * @param boxOldPosition zone position of the box before the push
+	 * @param boxNewPosition zone position of the box after the push
+	 * @param pusherNewPosition level position of the pusher after the push
+	 * @param direction direction of the push ('L', 'R', 'U' or 'D')
+	 */
+	inline void setPush(Push* push, const int boxOldPosition,
+			const int boxNewPosition, const int pusherNewPosition,
+			const char direction) const
+	{
+		push->boxOldPosition = boxOldPosition;
+		push->boxNewPosition = boxNewPosition;
+		push->pusherNewPosition = pusherNewPosition;
+		push->direction = direction;
+		push->pushCost = 1;
+	}
 };
 
 #endif /*NODE_H_*/
@@ -0,0 +1,31 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief More a usefull structure than a class. Compact description of a
+ * push found by Node::findPushes.
+ *
+ * Pushes are written in a tab owned by the solver and reused for every
+ * processed node. The node of a push is only created with Node::createChild
+ * (when push survives cheap tests).
+ */
+/*----------------------------------------------*/
+
+#ifndef PUSH_H_
+#define PUSH_H_
+
+class Push
+{
+public :
+	int boxOldPosition; /**< Zone position of the box before the push */
+	int boxNewPosition; /**< Zone position of the box after the push */
+	int pusherNewPosition; /**< Level position of the pusher after the push */
+	char direction; /**< Direction of the push ('L', 'R', 'U' or 'D') */
+	int pushCost; /**< Number of pushes (more than 1 through a tunnel) */
+};
+
+#endif /*PUSH_H_*/
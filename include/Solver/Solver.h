@@ -19,6 +19,7 @@
 #include "../Base.h"
 #include "../Level.h"
 #include "Zone.h"
+#include "Push.h"
 
 class TreeNode;
 class HashTable;
@@ -26,6 +27,10 @@ class ChainedList;
 class Node;
 class Stats;
 class Deadlock;
+class VerdictCache;
+class DijkstraBox;
+class GoalRoom;
+class LevelContext;
 
 class Solver
 {
@@ -38,11 +43,24 @@ protected:
 	HashTable* closeTable; /**< hashTable where all closed nodes are keeped */
 	ChainedList* closeNodeList; /**< found nodes but not processed yet */
 	Deadlock* deadlockEngine; /**< Management object for all deadlocks */
-	Zone* goalZone; /**< Zone representation of all goals in this level */
-	int* goalsPositions; /**< zone positions of every goals */
-	int* zoneToLevelPos; /**< translation table between new positions in zone and old positions in level */
+	VerdictCache* verdictCache; /**< Cache of deadlock verdicts */
+	bool sharedVerdictCache; /**< True if verdictCache belongs to another object */
+	LevelContext* levelContext; /**< Tables of the level that don't depend on boxes (NULL if not created yet) */
+	bool sharedLevelContext; /**< True if levelContext and its tables belong to another object */
+	const Zone* goalZone; /**< Zone representation of all goals in this level */
+	const int* goalsPositions; /**< zone positions of every goals */
+	const int* zoneToLevelPos; /**< translation table between new positions in zone and old positions in level */
 	int zoneToLevelPosLength; /**< Length of translation table */
-	int* levelToZonePos; /**< translation table between old positions in level and new positions in zone */
+	const int* levelToZonePos; /**< translation table between old positions in level and new positions in zone */
+	const Zone* deadSquareZone; /**< Zone representation of positions where a box is always deadlocked */
+	const int* zoneToBoxPos; /**< translation table between positions in zone and positions in box index space (-1 if dead square) */
+	const int* boxToZonePos; /**< translation table between positions in box index space and positions in zone */
+	int boxToZonePosLength; /**< Length of box index space (positions a box can occupy) */
+	Push* pushes; /**< Reusable tab of pushes found from the processed node (4 by box) */
+	Zone* pushBoxesZone; /**< Reusable zone of boxes after a push, before its node is created */
+	DijkstraBox* dijkstraBox; /**< Reusable search of box moves */
+	GoalRoom* goalRoom; /**< Goal room of the level and order to fill it */
+	const bool* tunnelTab; /**< For each zone position (2*pos for horizontal moves, 2*pos+1 for vertical moves) : true if walls on both sides */
 	int nodeNumber; /**< Number of explored nodes */
 	int maxNodeNumber; /**< Max number of explored nodes */
 	int ramSize; /**< Actual used ram size */
@@ -88,6 +106,8 @@ public:
 	inline Base* getBase(void) const { return base; }
 	/** @Return Level assigned to solver */
 	inline const Level* getLevel(void) const { return level; }
+	/** @Return Reusable search of box moves (one search at a time) */
+	inline DijkstraBox* getDijkstraBox(void) const { return dijkstraBox; }
 	/** @Return Stats of this solver */
 	inline const Stats* getStats(void) const { return stats; }
 	/** @Return Tree we build when solving */
@@ -104,6 +124,14 @@ public:
 	{ return closeNodeList; }
 	/** @Return Management of deadlock positions */
 	inline const Deadlock* getDeadlockEngine(void) const { return deadlockEngine; }
+	/** @Return Table of minimum number of pushes between every box index
+	 * position and zone position (NULL if this solver doesn't use one) */
+	virtual const int* const* getCostTable(void) const { return NULL; }
+	/** @Return Tables of the level that don't depend on boxes (NULL if not
+	 * created yet) */
+	inline LevelContext* getLevelContext(void) const { return levelContext; }
+	/** @Return Cache of deadlock verdicts */
+	inline VerdictCache* getVerdictCache(void) const { return verdictCache; }
 	/** @Return Binary representation of the goals */
 	inline const Zone* getGoalZone(void) const { return goalZone; }
 	/** @Return goal positions of every goals */
@@ -114,6 +142,28 @@ public:
 	inline const int getZoneToLevelPosLength(void) const { return zoneToLevelPosLength; }
 	/** @Return Translation table between level and zone */
 	inline const int* getLevelToZonePos(void) const { return levelToZonePos; }
+	/** @Return Positions where a box is always deadlocked */
+	inline const Zone* getDeadSquareZone(void) const { return deadSquareZone; }
+	/**
+	 * @Return true if a box or pusher moving on a zone position has walls on
+	 * both sides (horizontal is true for left and right moves)
+	 */
+	inline bool isTunnel(int zonePos, bool horizontal) const
+	{ return tunnelTab[2*zonePos + (horizontal ? 0 : 1)]; }
+	/** @Return Tunnels of each zone position (see isTunnel) */
+	inline const bool* getTunnelTab(void) const { return tunnelTab; }
+	/** @Return Goal room of the level and order to fill it */
+	inline const GoalRoom* getGoalRoom(void) const { return goalRoom; }
+	/** @Return true if the order to fill the goal room is used (packed boxes
+	 * not moved again) : best solution can be lost, only for solvers that
+	 * don't need it */
+	virtual bool usesPackingOrder(void) const { return false; }
+	/** @Return Translation table between zone and box index space */
+	inline const int* getZoneToBoxPos(void) const { return zoneToBoxPos; }
+	/** @Return Translation table between box index space and zone */
+	inline const int* getBoxToZonePos(void) const { return boxToZonePos; }
+	/** @Return Length of box index space */
+	inline const int getBoxToZonePosLength(void) const { return boxToZonePosLength; }
 	/** @Return nodeNumber */
 	inline const int getNodeNumber(void) const { return nodeNumber; }
 	/** @Return maximum Node Number */
@@ -122,12 +172,27 @@ public:
 	inline const int getMaxRamSize(void) const { return maxRamSize; }
 	/** @Return maximum ram size */
 	inline const int getDeadlockedBoxesSearch(void) const { return deadlockedBoxesSearch; }
+	/** @Return true if only number of pushes is kept (no path, no files) */
+	inline const bool getOnlyPushNumber(void) const { return onlyPushNumber; }
 	/** @Return value of solved (true if solved or impossible, false if not) */
 	inline const int getSolved(void) const { return solved; }
 
 	/* --------*/
 	/* Setters */
 	/* --------*/
+	/**
+	 * Use a cache of deadlock verdicts owned by another object (verdicts of
+	 * the same level can be shared by many solvers)
+	 * @param verdictCache cache to use (not deleted by this solver)
+	 */
+	void setVerdictCache(VerdictCache* verdictCache);
+
+	/**
+	 * Use tables of a level analysis owned by another object instead of
+	 * computing them (level must have same walls and goals)
+	 * @param levelContext context to use (not deleted by this solver)
+	 */
+	void setLevelContext(LevelContext* levelContext);
 
 	/* -------*/
 	/* Others */
@@ -182,18 +247,27 @@ protected:
 	virtual void addTreeNodeToCloseList(TreeNode* treeNode) = 0;
 
 	/**
-	 * Get list of children from a treeNode and move this treenode from
-	 * close list to open list
-	 * @return list of children (terminated by NULL)
+	 * Write pushes of a treeNode in pushes tab and move this treenode from
+	 * close list to open list. Pushes of a box on a dead square are skipped.
+	 * @return number of pushes written in pushes tab
 	 */
-	virtual Node** findChildren(TreeNode* treeNode);
+	virtual int findPushes(TreeNode* treeNode);
 
 	/**
-	 * look if a node was already searched in the past
-	 * @param node to test
+	 * look if a node was already searched in the past (see
+	 * HashTable::getTreeNodeFromState)
+	 * @param boxesZone boxes of the node to test
+	 * @param pusherPos position of pusher in the node (zone representation)
 	 * @return true if node is already searched (open or close node)
 	 */
-	virtual bool isAlreadySearched(Node* node);
+	virtual bool isAlreadySearched(const Zone* boxesZone, int pusherPos);
+
+	/**
+	 * Initialize tables of the level that don't depend on boxes (translation
+	 * tables, goals, dead squares, box index space and tunnels). They are
+	 * taken from levelContext if one is set.
+	 */
+	virtual void initLevelTables(void);
 
  	/**
  	 * Find every usefull position in the level and make a translation table
@@ -213,6 +287,29 @@ protected:
 	 */
 	virtual void initGoalZone(void);
 
+	/**
+	 * Find dead squares (corners, lines and positions from where a box alone
+	 * can't reach a goal) and make translation tables between positions in
+	 * zone and a denser box index space without dead squares.
+	 */
+	virtual void initBoxToZonePos(void);
+
+	/**
+	 * Allocate tab of pushes and zone of boxes reused for every processed
+	 * node
+	 */
+	virtual void initPushes(void);
+
+	/**
+	 * Find tunnels : positions with walls on both sides of a move
+	 */
+	virtual void initTunnels(void);
+
+	/**
+	 * Find goal room of the level and order to fill it
+	 */
+	virtual void initGoalRoom(void);
+
 	/**
 	 * Initialize deadlock engine of level we want to resolve.
 	 */
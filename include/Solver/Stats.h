@@ -37,6 +37,10 @@ protected:
 	 */
 	int numOfPushes;
 	char* message; /**< Message to be printed with stats */
+	long long* checkCalls; /**< Number of calls of each deadlock check */
+	long long* checkHits; /**< Number of deadlocks found by each check */
+	long long* checkTimes; /**< Time spent in each check (nanoseconds) */
+	bool* checkEnabled; /**< False for each check disabled by the solver */
 
 public:
 	/**
@@ -49,7 +53,7 @@ public:
 	 * @param message Message to be printed with stats
 	 */
 	Stats(Base* base, Solver* solver, TreeNode* treeNode, Path* solutionPath,
-			int numOfPushes, char* message);
+			int numOfPushes, const char* message);
 
 	/**
 	 * Constructor to copy another stats object
@@ -79,6 +83,14 @@ public:
 	inline int getNumOfPushes(void) const { return numOfPushes; }
 	/** @Return message */
 	inline char* getMessage(void) const { return message; }
+	/** @Return number of calls of each deadlock check (NULL if unknown) */
+	inline const long long* getCheckCalls(void) const { return checkCalls; }
+	/** @Return number of deadlocks found by each check */
+	inline const long long* getCheckHits(void) const { return checkHits; }
+	/** @Return time spent in each check (nanoseconds) */
+	inline const long long* getCheckTimes(void) const { return checkTimes; }
+	/** @Return false for each disabled check */
+	inline const bool* getCheckEnabled(void) const { return checkEnabled; }
 
 	/* --------*/
 	/* Setters */
@@ -108,6 +120,16 @@ public:
 
 protected:
 
+	/**
+	 * Copy counters of deadlock checks
+	 * @param calls number of calls of each check (NULL if unknown)
+	 * @param hits number of deadlocks found by each check
+	 * @param times time spent in each check (nanoseconds)
+	 * @param enabled false for each disabled check
+	 */
+	void copyChecks(const long long* calls, const long long* hits,
+			const long long* times, const bool* enabled);
+
 	/**
 	 * Print stats in text mode in a file or in the shell.
 	 * @param fileName name of the file we want to print in. If NULL, then
@@ -0,0 +1,141 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+/**
+ * @brief Cache of deadlock verdicts keyed by a local configuration
+ *
+ * Each key is a tab of words (zones and flags) built by the deadlock engine.
+ * Items are stored in a hash table of chained items and in a list ordered
+ * by last use. When the cache is full, the least recently used item is
+ * removed.
+ */
+/*----------------------------------------------*/
+
+#ifndef VERDICTCACHE_H_
+#define VERDICTCACHE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+class VerdictCacheItem
+{
+public:
+	unsigned int* key; /**< Words of the key */
+	int keyLength; /**< Number of words of the key */
+	int verdict; /**< Stored verdict */
+	VerdictCacheItem* next; /**< Next item of the same hash cell */
+	VerdictCacheItem* older; /**< Item used just before this one */
+	VerdictCacheItem* newer; /**< Item used just after this one */
+	VerdictCacheItem(const unsigned int* key, int keyLength, int verdict):
+		keyLength(keyLength),
+		verdict(verdict),
+		next(NULL),
+		older(NULL),
+		newer(NULL)
+	{
+		this->key = (unsigned int*)malloc(keyLength*sizeof(unsigned int));
+		memcpy(this->key, key, keyLength*sizeof(unsigned int));
+	}
+	~VerdictCacheItem()
+	{
+		free(key);
+	}
+};
+
+class VerdictCache
+{
+protected:
+	VerdictCacheItem** table; /**< Table of hashing */
+	int length; /**< Length of hashtable : number of cells */
+	int itemNumber; /**< Number of items in the cache */
+	int maxItemNumber; /**< Max number of items before removing old ones */
+	VerdictCacheItem* newest; /**< Most recently used item */
+	VerdictCacheItem* oldest; /**< Least recently used item */
+	int hitNumber; /**< Number of found verdicts */
+	int missNumber; /**< Number of unknown verdicts */
+
+public:
+	/** Verdict is not in the cache */
+	static const int VERDICT_UNKNOWN = -1;
+	/** Configuration is not deadlocked */
+	static const int VERDICT_FREE = 0;
+	/** Configuration is deadlocked */
+	static const int VERDICT_DEADLOCK = 1;
+
+	/**
+	 * Constructor
+	 * @param length number of cells of the hash table
+	 * @param maxItemNumber max number of verdicts kept in the cache
+	 */
+	VerdictCache(int length, int maxItemNumber);
+
+	/**
+	 * Destructor
+	 */
+	~VerdictCache();
+
+	/* --------*/
+	/* Getters */
+	/* --------*/
+	/** @Return length of table */
+	inline int getLength(void) const { return length; }
+	/** @Return number of items stocked in the cache */
+	inline int getItemNumber(void) const { return itemNumber; }
+	/** @Return number of found verdicts */
+	inline int getHitNumber(void) const { return hitNumber; }
+	/** @Return number of unknown verdicts */
+	inline int getMissNumber(void) const { return missNumber; }
+
+	/* -------*/
+	/* Others */
+	/* -------*/
+	/**
+	 * Get the verdict of a key. A found item becomes the most recently used
+	 * @param key words of the key
+	 * @param keyLength number of words of the key
+	 * @return stored verdict or VERDICT_UNKNOWN
+	 */
+	int getVerdict(const unsigned int* key, int keyLength);
+
+	/**
+	 * Add the verdict of a key (key must not be present). If the cache is
+	 * full, least recently used item is removed
+	 * @param key words of the key
+	 * @param keyLength number of words of the key
+	 * @param verdict VERDICT_FREE or VERDICT_DEADLOCK
+	 */
+	void addVerdict(const unsigned int* key, int keyLength, int verdict);
+
+protected:
+	/**
+	 * Hashing function that use a key to compute an index number for the tab
+	 * @param key words of the key
+	 * @param keyLength number of words of the key
+	 * @return index number for the tab
+	 */
+	int h(const unsigned int* key, int keyLength) const;
+
+	/**
+	 * Remove an item from the list ordered by last use
+	 * @param item item to unlink
+	 */
+	void unlinkItem(VerdictCacheItem* item);
+
+	/**
+	 * Put an item at the head of the list ordered by last use
+	 * @param item item to link
+	 */
+	void linkNewestItem(VerdictCacheItem* item);
+
+	/**
+	 * Remove and delete least recently used item
+	 */
+	void removeOldestItem(void);
+};
+
+#endif /*VERDICTCACHE_H_*/
@@ -43,6 +43,7 @@ class Zone
 protected:
 	unsigned int* zone; /**< binary representation of the zone */
 	int length; /**< Number of positions in the zone */
+	int numberCell; /**< Number of cells used by zone (set with length) */
 
 public:
 	static const int PROCESS_BOXES	  = 0;
@@ -118,6 +119,21 @@ public:
 	Zone(const Zone* boxes, const int startPos,	const int* levelToZonePos,
 			int colsNumber);
 
+	/**
+	 * Constructor for pusher zone of a child node after a push. Pusher zone of
+	 * parent node is updated around the pushed box : it's only made again
+	 * from startPos when the new box position may split the pusher zone.
+	 * @param parentPusher Pusher zone of the parent node (before the push)
+	 * @param boxes Boxes zone of the child node (after the push)
+	 * @param startPos Old position of the box, position of the pusher after
+	 * the push (level representation)
+	 * @param boxPos New position of the box (level representation)
+	 * @param levelToZonePos Link between real positions and zone positions
+	 * @param colsNumber Number of cols in level
+	 */
+	Zone(const Zone* parentPusher, const Zone* boxes, const int startPos,
+			const int boxPos, const int* levelToZonePos, int colsNumber);
+
 	/**
 	 * Destructor
 	 */
@@ -138,18 +154,8 @@ public:
 	/* -------*/
 	/* Others */
 	/* -------*/
-	/**
-	 * Calculate number of cells usefull to represent this zone
-	 */
-	inline int getNumberCell(void) const
-	{
-		int cellSize = 8*sizeof(unsigned int);
-		int rest = length%cellSize;
-		if(rest > 0)
-			return 1+length/cellSize;
-		else
-			return length/cellSize;
-	}
+	/** @Return Number of cells usefull to represent this zone */
+	inline int getNumberCell(void) const { return numberCell; }
 
 	/**
 	 * Print a zone in integer and binary mode
@@ -179,7 +185,7 @@ public:
 		// Position of the bit in tab[cell] (starting with 0)
 		int bitPos = pos%cellSize;
 
-		if(bitCell < getNumberCell() && bitCell >= 0)
+		if(bitCell < numberCell && bitCell >= 0)
 			return (this->zone[bitCell] >> (cellSize-1-bitPos)) & 1;
 		else
 		{
@@ -235,13 +241,54 @@ public:
 	 */
 	int getNumberOf1() const;
 
+	/**
+	 * Test if this zone and another zone have a common position (no zone is
+	 * created)
+	 * @param otherZone zone to test with this zone
+	 * @return true if a position is 1 in both zones
+	 */
+	bool intersects(const Zone* otherZone) const;
+
+	/**
+	 * Test if binary operation AND between this zone and another zone is
+	 * full of 0 (no zone is created)
+	 * @param otherZone zone to test with this zone
+	 * @return true if no position is 1 in both zones
+	 */
+	bool andIsEmpty(const Zone* otherZone) const;
+
+	/**
+	 * Return number of 1 of binary operation AND between this zone and
+	 * another zone (no zone is created)
+	 * @param otherZone zone to test with this zone
+	 * @return number of positions that are 1 in both zones
+	 */
+	int andPopcount(const Zone* otherZone) const;
+
+	/**
+	 * Test if this zone and another zone are egal on positions of a mask
+	 * (no zone is created)
+	 * @param otherZone zone to compare to this zone
+	 * @param maskZone only positions that are 1 in this zone are compared
+	 * @return true if zones are the same on every position of maskZone
+	 */
+	bool isEgalIn(const Zone* otherZone, const Zone* maskZone) const;
+
+	/**
+	 * Write binary operation this zone AND NOT another zone in an existing
+	 * zone of same length (no zone is created)
+	 * @param otherZone zone removed from this zone
+	 * @param destZone zone where the result is written (can be this zone)
+	 */
+	void andNotInto(const Zone* otherZone, Zone* destZone) const;
+
 	/**
 	 * Make a zone representation resulting of a binary operation OR between
 	 * this zone and the other zone
 	 * @param otherZone Zone to make binary operation with
 	 * @return resulting zone (this zone that's actually modified)
 	 */
-	Zone* applyOrWith(Zone* otherZone);
+	Zone* applyOrWith(const Zone* otherZone);
 
 	/**
 	 * Make a zone representation resulting of a binary operation AND between
@@ -249,7 +296,7 @@ public:
 	 * @param otherZone Zone to make binary operation with
 	 * @return resulting zone (this zone that's actually modified)
 	 */
-	Zone* applyAndWith(Zone* otherZone);
+	Zone* applyAndWith(const Zone* otherZone);
 
 	/**
 	 * Make a zone representation resulting of a binary operation XOR between
@@ -257,7 +304,7 @@ public:
 	 * @param otherZone Zone to make binary operation with
 	 * @return resulting zone (this zone that's actually modified)
 	 */
-	Zone* applyXorWith(Zone* otherZone);
+	Zone* applyXorWith(const Zone* otherZone);
 
 	/**
 	 * Make a zone representation resulting of a binary operation XOR between
@@ -266,18 +313,55 @@ public:
 	 */
 	Zone* applyNot();
 
+	/**
+	 * Write 0 to every position of this zone
+	 */
+	void clear(void);
+
 	/**
 	 * Make a zone representation resulting of a MINUS binary operation between
 	 * this zone and the other zone
 	 * @return resulting zone (this zone that's actually modified)
 	 */
-	Zone* applyMinusWith(Zone* otherZone);
+	Zone* applyMinusWith(const Zone* otherZone);
 
 	/**
 	 * Save this zone directly into a file
 	 */
 	void saveInFile(FILE* file);
 
+	/**
+	 * Save words of this zone into a binary file
+	 * @param file handle to opened file
+	 */
+	void saveInBinaryFile(FILE* file) const;
+
+	/**
+	 * Replace words of this zone by words read from a binary file
+	 * @param file handle to opened file
+	 * @return true if every word was read, false if not
+	 */
+	bool loadFromBinaryFile(FILE* file);
+
+	/**
+	 * Get the 8 positions around a position, each one next to the previous
+	 * one (neighbours of pos have odd indexes)
+	 * @param pos position (level representation)
+	 * @param colsNumber Number of cols in level
+	 * @param around tab of 8 positions to be filled
+	 */
+	static void getAroundPositions(const int pos, const int colsNumber,
+			int* around);
+
+	/**
+	 * Test if free neighbours of a position are connected by the 8 positions
+	 * around it (see getAroundPositions)
+	 * @param freeAround true for each free position around
+	 * @return true if free neighbours are connected, false if filling the
+	 * position may split a zone
+	 */
+	static bool isAroundConnected(const bool* freeAround);
+
 protected:
 	/**
 	 * Make a zone representation of boxes positions in a level
@@ -308,6 +392,30 @@ protected:
 	void recursiveMakePusherZone(const Zone* boxes, const int startPos,
 			const int* levelToZonePos, const int colsNumber);
 
+	/**
+	 * Test if free neighbours of a position stay connected around it when
+	 * this position is filled (only the 8 positions around are used)
+	 * @param boxes Zone representation of boxes in this level
+	 * @param pos Filled position (level representation)
+	 * @param levelToZonePos Link between level positions and zone positions
+	 * @param colsNumber Number of cols in level
+	 * @return true if free neighbours are connected by the 8 positions around
+	 * pos, false if filling pos may split a zone
+	 */
+	bool isLocallyConnected(const Zone* boxes, const int pos,
+			const int* levelToZonePos, const int colsNumber) const;
+
+	/**
+	 * Set 0 on a box position of pusher zone if pusher can't reach any of its
+	 * neighbours
+	 * @param boxes Zone representation of boxes in this level
+	 * @param pos Box position (level representation)
+	 * @param levelToZonePos Link between level positions and zone positions
+	 * @param colsNumber Number of cols in level
+	 */
+	void updatePusherBox(const Zone* boxes, const int pos,
+			const int* levelToZonePos, const int colsNumber);
+
 	/**
 	 * Make a zone representation of places where deadlocks appear if a box
 	 * is on it
@@ -341,6 +449,20 @@ protected:
 	void makeLineDeadlockZone(const Level* level, const int* levelToZonePos,
 			const int* zoneToLevelPos);
 
+	/**
+	 * This function add every position from where a box alone can't reach
+	 * any goal. A box is pulled backwards from every goal on the empty level
+	 * (pusher on every side it can reach) and every position never reached
+	 * is a deadlock. You must apply this function AFTER the use of function
+	 * makeLineDeadlockZone because marked positions are read as corners.
+	 * @param level Level we want to make zone
+	 * @param levelToZonePos Link between level positions and zone positions
+	 * @param zoneToLevelPos Link between zone positions and real positions
+	 * in the level
+	 */
+	void makePullDeadlockZone(const Level* level, const int* levelToZonePos,
+			const int* zoneToLevelPos);
+
 	/**
 	 * Make a zone representation of goal places
 	 * @param level Level we want to make zone
@@ -376,6 +498,19 @@ protected:
 	 */
 	void makeNOTZone(const Zone* zone1);
 
+	/**
+	 * Set numberCell with length and allocate the tab of cells of zone.
+	 * Used by constructors, cells are not initialized.
+	 */
+	void allocateCells(void);
+
+	/**
+	 * Return mask of bits of last cell that are positions of zone (others
+	 * are padding, set to 1 by applyNot)
+	 * @return mask of last cell
+	 */
+	unsigned int lastCellMask(void) const;
+
 	/**
 	 * Copy other zone in this object. Used by constructor.
 	 * @param source zone to be copied in this object.
@@ -18,6 +18,7 @@
 #include <string.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <time.h>
 
 class Util
 {
@@ -108,6 +109,12 @@ public:
 	 */
 	static bool isThisRepExists(char* rep);
 
+	/**
+	 * Get time of a monotonic clock, used to measure durations
+	 * @return time in nanoseconds
+	 */
+	static long long getNanoTime(void);
+
 };
 
 #endif /*UTIL_H_*/
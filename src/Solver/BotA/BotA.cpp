@@ -17,7 +17,8 @@ BotA::BotA(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
 	Solver(base, level, maxNodeNumber, maxRamSize, openTableSize,
 			closeTableSize, deadlockedBoxesSearch, onlyPushNumber),
 	minReject(INT_MAX),
-	quickSearch(quickSearch)
+	quickSearch(quickSearch),
+	fringeTable(NULL)
 {
 	if(costLimit >= 0)
 		this->costLimit = costLimit;
@@ -28,6 +29,12 @@ BotA::BotA(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
 /* -----------*/
 /* Destructor */
 /* -----------*/
+BotA::~BotA()
+{
+	// Kept treeNodes are deleted with the tree
+	if(fringeTable)
+		delete fringeTable;
+}
 
 /* -------*/
 /* Others */
@@ -88,10 +95,6 @@ int BotA::getInitialCost()
 	int firstCost = ((BotA_TreeNode*)startTreeNode)->getF();
 
 	delete startTreeNode;
-	free(zoneToLevelPos);
-	free(levelToZonePos);
-	this->zoneToLevelPos = (int*)malloc(sizeof(int));
-	this->levelToZonePos = (int*)malloc(sizeof(int));
 
 	return firstCost;
 }
@@ -103,6 +106,7 @@ void BotA::process()
 	Child** children = NULL;
 	bool deadlockednode;
 	bool alreadysearched;
+	bool kept;
 
 	// Main loop (we stop after a limited number of iterations)
 	while(!solved)
@@ -134,7 +138,8 @@ void BotA::process()
 					children[i]->childCost);
 
 			// If node already present in open or close hashtable
-			alreadysearched = workOnAlreadySearched(childrenI, &counter);
+			alreadysearched = workOnAlreadySearched(childrenI, &counter,
+					&kept);
 
 			if(!alreadysearched)
 				deadlockednode = deadlockEngine->deadlockedNode(childrenI);
@@ -150,7 +155,7 @@ void BotA::process()
 				}
 				counter++;
 			}
-			else
+			else if(!kept)
 				delete childrenI;
 			delete children[i];
 
@@ -313,8 +318,10 @@ void BotA::saveMostUsedPositions(int numberOfPos)
 
 bool BotA::isDeadTreeNode(TreeNode* treeNode)
 {
-	// If this treeNode is not treated yet, this treeNode branch is alive
-	bool thisOne = closeTable->isPresent(treeNode->getNode());
+	// If this treeNode is not treated yet (or kept for next iteration),
+	// this treeNode branch is alive
+	bool thisOne = closeTable->isPresent(treeNode->getNode())
+			|| (fringeTable && fringeTable->isPresent(treeNode->getNode()));
 	if(thisOne)
 		return false;
 	else
@@ -347,20 +354,27 @@ void BotA::deleteDeadTreeNode(TreeNode* treeNode)
 		delete treeNode;
 }
 
-bool BotA::workOnAlreadySearched(TreeNode* treeNode, int* counter)
+bool BotA::workOnAlreadySearched(TreeNode* treeNode, int* counter,
+		bool* kept)
 {
 	bool alreadysearched = false;
 	Node* node = treeNode->getNode();
 	int newValue = ((BotA_TreeNode*)treeNode)->getF();
+	*kept = false;
 
 	// new value is not accepted in this iteration
 	if(newValue > costLimit)
 	{
 		if(newValue < minReject)
 			minReject = newValue;
+		if(fringeTable && newValue != INT_MAX)
+			*kept = workOnRejected(treeNode, counter);
 		return true;
 	}
 
+	if(fringeTable && workOnFringe(treeNode, counter))
+		return true;
+
 	TreeNode* oldOpenNode = openTable->getTreeNodeFromNode(node);
 	TreeNode* oldCloseNode = closeTable->getTreeNodeFromNode(node);
 
@@ -415,6 +429,62 @@ bool BotA::workOnAlreadySearched(TreeNode* treeNode, int* counter)
 	return alreadysearched;
 }
 
+bool BotA::workOnRejected(TreeNode* treeNode, int* counter)
+{
+	Node* node = treeNode->getNode();
+
+	// Already searched or waiting with a smaller cost
+	if(openTable->isPresent(node) || closeTable->isPresent(node))
+		return false;
+
+	TreeNode* oldFringeNode = fringeTable->getTreeNodeFromNode(node);
+	if(oldFringeNode == NULL)
+	{
+		fringeTable->addItem(treeNode);
+		(*counter)++;
+		return true;
+	}
+
+	// Kept treeNode has no children : only its cost and parent change
+	if(((BotA_TreeNode*)treeNode)->getF()
+			< ((BotA_TreeNode*)oldFringeNode)->getF())
+	{
+		((BotA_TreeNode*)oldFringeNode)->setF(
+				((BotA_TreeNode*)treeNode)->getF());
+		((BotA_TreeNode*)oldFringeNode)->setG(
+				((BotA_TreeNode*)treeNode)->getG());
+		moveTreeNode(oldFringeNode, treeNode->getParent());
+		(*counter)++;
+	}
+
+	return false;
+}
+
+bool BotA::workOnFringe(TreeNode* treeNode, int* counter)
+{
+	Node* node = treeNode->getNode();
+	TreeNode* oldFringeNode = fringeTable->getTreeNodeFromNode(node);
+	if(oldFringeNode == NULL)
+		return false;
+
+	fringeTable->removeItem(node);
+	if(deadlockEngine->deadlockedNode(treeNode))
+	{
+		delete oldFringeNode;
+		return true;
+	}
+
+	((BotA_TreeNode*)oldFringeNode)->setF(((BotA_TreeNode*)treeNode)->getF());
+	((BotA_TreeNode*)oldFringeNode)->setG(((BotA_TreeNode*)treeNode)->getG());
+	moveTreeNode(oldFringeNode, treeNode->getParent());
+
+	closeTable->addItem(oldFringeNode);
+	addTreeNodeToCloseList(oldFringeNode);
+	(*counter)++;
+
+	return true;
+}
+
 TreeNode* BotA::firstTreeNode(void)
 {
 	TreeNode* treeNode = NULL;
@@ -455,14 +525,135 @@ Child** BotA::findPonderedChildren(TreeNode* treeNode)
 	{
 		closeTable->removeItem(treeNode->getNode());
 		openTable->addItem(treeNode);
-		Node** children = treeNode->getNode()->findChildren();
 
-		return treeNode->getNode()->findMacroChildren(children);
+		Node* node = treeNode->getNode();
+		int pushNumber = findNodePushes(node, pushes);
+		pushNumber = removeSearchedPushes(treeNode, pushes, pushNumber);
+		return node->findMacroChildren(pushes, pushNumber);
 	}
 	else
 		return NULL;
 }
 
+Child** BotA::findNodeChildren(Node* node, Push* pushes)
+{
+	int pushNumber = findNodePushes(node, pushes);
+	return node->findMacroChildren(pushes, pushNumber);
+}
+
+int BotA::findNodePushes(const Node* node, Push* pushes)
+{
+	int pushNumber = node->findPushes(pushes, deadSquareZone);
+	pushNumber = restrictToPICorral(node, pushes, pushNumber);
+	pushNumber = restrictToGoalRoom(node, pushes, pushNumber);
+
+	// A box pushed in a tunnel is carried to its end
+	for(int i=0;i<pushNumber;i++)
+		node->applyTunnel(&pushes[i]);
+
+	return removeDeadlockedPushes(node, pushes, pushNumber);
+}
+
+int BotA::restrictToPICorral(const Node* node, Push* pushes, int pushNumber)
+{
+	Zone* piCorralZone = deadlockEngine->createPICorralZone(node);
+	if(piCorralZone == NULL)
+		return pushNumber;
+
+	// Every box of the PI-corral is a box of node : a push keeps all of them
+	// in child unless it moves one of them
+	int keptNumber = 0;
+	for(int i=0;i<pushNumber;i++)
+	{
+		if(piCorralZone->readPos(pushes[i].boxOldPosition) == 1)
+		{
+			pushes[keptNumber] = pushes[i];
+			keptNumber++;
+		}
+	}
+
+	delete piCorralZone;
+
+	return keptNumber;
+}
+
+int BotA::restrictToGoalRoom(const Node* node, Push* pushes, int pushNumber)
+{
+	int packedNumber = goalRoom->getPackedNumber(node->getBoxesZone());
+	if(packedNumber == 0)
+		return pushNumber;
+
+	int keptNumber = 0;
+	for(int i=0;i<pushNumber;i++)
+	{
+		if(!goalRoom->isPacked(pushes[i].boxOldPosition, packedNumber))
+		{
+			pushes[keptNumber] = pushes[i];
+			keptNumber++;
+		}
+	}
+
+	return keptNumber;
+}
+
+int BotA::removeDeadlockedPushes(const Node* node, Push* pushes,
+		int pushNumber)
+{
+	int keptNumber = 0;
+	for(int i=0;i<pushNumber;i++)
+	{
+		node->writeChildBoxes(&pushes[i], pushBoxesZone);
+		if(!deadlockEngine->deadlockedPush(pushBoxesZone,
+				zoneToLevelPos[pushes[i].boxNewPosition]))
+		{
+			pushes[keptNumber] = pushes[i];
+			keptNumber++;
+		}
+	}
+
+	return keptNumber;
+}
+
+int BotA::removeSearchedPushes(TreeNode* treeNode, Push* pushes,
+		int pushNumber)
+{
+	// Rejected nodes update minReject or the fringe even if already searched
+	if(costLimit != INT_MAX || fringeTable)
+		return pushNumber;
+
+	Node* node = treeNode->getNode();
+	int keptNumber = 0;
+	for(int i=0;i<pushNumber;i++)
+	{
+		int pushG = getPushG(treeNode, &pushes[i]);
+		TreeNode* oldTreeNode = NULL;
+		if(pushG != -1)
+		{
+			node->writeChildBoxes(&pushes[i], pushBoxesZone);
+			int pusherPos = levelToZonePos[pushes[i].pusherNewPosition];
+			oldTreeNode = openTable->getTreeNodeFromState(pushBoxesZone,
+					pusherPos);
+			if(oldTreeNode == NULL)
+				oldTreeNode = closeTable->getTreeNodeFromState(pushBoxesZone,
+						pusherPos);
+		}
+
+		// h(x) of a node never decreases : f(x) of child wouldn't be smaller
+		if(oldTreeNode == NULL || ((BotA_TreeNode*)oldTreeNode)->getG() > pushG)
+		{
+			pushes[keptNumber] = pushes[i];
+			keptNumber++;
+		}
+	}
+
+	return keptNumber;
+}
+
+int BotA::getPushG(TreeNode* parentTreeNode, const Push* push) const
+{
+	return -1;
+}
+
 void BotA::addTreeNodeToCloseList(TreeNode* treeNode)
 {
 	((BotA_HeapStack*)closeNodeList)->addItem(treeNode);
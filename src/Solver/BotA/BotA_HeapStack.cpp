@@ -94,8 +94,9 @@ bool BotA_HeapStack::isSmaller(int cell1, int cell2) const
 	int costLimit = ((BotA*)solver)->getCostLimit();
 
 	// If costLimit = +infty, then use of A* with no limit, else if
-	// costLimit = value, then use of A* with IDA* and quick result
-	if(costLimit == INT_MAX)
+	// costLimit = value, then use of A* with IDA* and quick result. Fringe
+	// search keeps best-first order : first solution found is the best one
+	if(costLimit == INT_MAX || ((BotA*)solver)->getFringeTable() != NULL)
 		return
 		(treeNodeTab[cell1]->getF() < treeNodeTab[cell2]->getF()
 		  ||(  treeNodeTab[cell1]->getF() == treeNodeTab[cell2]->getF()
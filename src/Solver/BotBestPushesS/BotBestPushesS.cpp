@@ -8,6 +8,7 @@
 
 #include "../../../include/Solver/BotBestPushesS/BotBestPushesS.h"
 #include "../../../include/Solver/BotBestPushesS/BotBestPushesS_Penalties.h"
+#include "../../../include/Solver/LevelContext.h"
 
 //TODO Bad include but it's working, try to do it in another way
 #include "BotBestPushesS_Matrix.cpp"
@@ -45,9 +46,12 @@ BotBestPushesS::BotBestPushesS(Base* base, Level* level, int maxNodeNumber,
 /* -----------*/
 BotBestPushesS::~BotBestPushesS()
 {
-	for(int i=0;i<zoneToLevelPosLength;i++)
-		free(costTable[i]);
-	free(costTable);
+	if(costTable && (!sharedLevelContext || !levelContext->getCostTable()))
+	{
+		for(int i=0;i<boxToZonePosLength;i++)
+			free((int*)costTable[i]);
+		free((int**)costTable);
+	}
 	delete penaltiesEngine;
 	if(emptyLevel)
 		delete emptyLevel;
@@ -58,12 +62,10 @@ BotBestPushesS::~BotBestPushesS()
 /* -------*/
 void BotBestPushesS::initialize(void)
 {
-	// Create translation tables between zone and level
-	initZoneToLevelPos();
-	initLevelToZonePos();
-
-	// Initialize fixed deadlock and goals Zones
-	initGoalZone();
+	// Create translation tables, fixed deadlock and goals Zones
+	initLevelTables();
+	initPushes();
+	initGoalRoom();
 	initDeadlockEngine();
 
 	// Initialize hash table
@@ -73,7 +75,14 @@ void BotBestPushesS::initialize(void)
 	initCloseNodeList();
 
 	// Initialize cost table
-	costTable = initCostTable();
+	if(sharedLevelContext && levelContext->getCostTable())
+		costTable = levelContext->getCostTable();
+	else
+		costTable = initCostTable();
+
+	// Tables of this level are shared with solvers of penalties and analyzes
+	if(!levelContext)
+		levelContext = new LevelContext(this);
 
 	// Initialize penalties
 	penaltiesEngine = new BotBestPushesS_Penalties(this);
@@ -227,6 +236,7 @@ void BotBestPushesS::analyzeNode(const Node* node, int boxLevelPos, int maxNodes
 		Solver* newSolver = new BotBestPushesS(base, testLevel,
 				numOfNodes, ramSize, 503, 251, costLimit,
 				deadlockedBoxesSearch, true);
+		newSolver->setLevelContext(levelContext);
 		newSolver->resolve();
 
 		char* message = (char*)malloc(255*sizeof(char));
@@ -392,8 +402,8 @@ void BotBestPushesS::processDeductive()
 //			for(int j=0;j<numOfBoxes;j++)
 //				printf("%d | ", ded[i][j]);
 //			printf("\n");
-//
-//			deadlockEngine->deadlockListTest(ded[i], numOfBoxes);
+
+			deadlockEngine->deadlockListTest(ded[i], numOfBoxes);
 
 			printf("penalty deductive test : ");
 			for(int j=0;j<numOfBoxes;j++)
@@ -405,6 +415,10 @@ void BotBestPushesS::processDeductive()
 			count--;
 			if(count == 0)
 			{
+				// Deadlocks found are kept before tested positions are
+				// removed from the file
+				deadlockEngine->saveDeadlockList();
+
 				FILE* ffile = fopen(fileName, "w");
 				for(int j=i;j<dedNumber;j++)
 				{
@@ -422,6 +436,8 @@ void BotBestPushesS::processDeductive()
 			}
 		}
 
+		deadlockEngine->saveDeadlockList();
+
 		for(int i=0;i<dedNumber;i++)
 			free(ded[i]);
 		free(ded);
@@ -462,6 +478,12 @@ int BotBestPushesS::g(TreeNode* treeNode, int pushCost) const
 	}
 }
 
+int BotBestPushesS::getPushG(TreeNode* parentTreeNode, const Push* push)
+		const
+{
+	return ((BotA_TreeNode*)parentTreeNode)->getG() + push->pushCost;
+}
+
 int BotBestPushesS::h(TreeNode* treeNode) const
 {
 	int sum = 0;
@@ -489,6 +511,9 @@ int BotBestPushesS::h(TreeNode* treeNode) const
 	BotBestPushesS_Matrix<double>* assignMatrix =
 		createAssignationMatrix(boxesPositions, goalsPositions);
 
+	// Packed boxes of the goal room stay on their goal
+	freezePackedBoxes(assignMatrix, boxesZone, boxesPositions, goalsPositions);
+
 	// Apply Munkres algorithm to matrix.
 	// lowerCostIndex[0] is best goal for first box, lowerCostIndex[1] is best
 	// goal for second box, ...
@@ -498,7 +523,7 @@ int BotBestPushesS::h(TreeNode* treeNode) const
 	for(int i=0;i<level->getBoxesNumber();i++)
 	{
 		int j = lowerCostIndex[i];
-		int a = costTable[boxesPositions[i]][goalsPositions[j]];
+		int a = getCost(boxesPositions[i], goalsPositions[j]);
 		if(a == INT_MAX)
 		{
 			sum = INT_MAX;
@@ -542,10 +567,10 @@ int** BotBestPushesS::initCostTable()
 
 	char* fileLine = Util::generateRep(file);
 
-	int** cTable;
+	int** cTable = NULL;
 	if(Util::isThisFileExists(fileLine))
 		cTable = loadCostTable(fileLine);
-	else
+	if(cTable == NULL)
 		cTable = createCostTable();
 
 	for(int i=0;i<5;i++)
@@ -558,44 +583,21 @@ int** BotBestPushesS::initCostTable()
 
 int** BotBestPushesS::createCostTable()
 {
-	int m = level->getRowsNumber();
-	int n = level->getColsNumber();
-
-	int zoneLength = 0;
-	int* zonePos = (int*)malloc(sizeof(int));
-	for(int i=0;i<m*n;i++)
-	{
-		char c = level->readPos(i);
-		// Compute number of position in zone representation of level
-		if(c != '#' && c != ' ')
-		{
-			zoneLength++;
-			zonePos=(int*)realloc(zonePos, zoneLength*sizeof(int));
-			zonePos[zoneLength-1] = i;
-		}
-	}
-
-	// number of zone positions
+	// File keeps a row for every zone position : it doesn't depend on goals
+	// (and dead squares) of the solved level
 	int** cTable;
-	cTable = (int**)malloc(zoneLength*sizeof(int*));
-	for(int i=0;i<zoneLength;i++)
-		cTable[i] = (int*)malloc(zoneLength*sizeof(int));
+	cTable = (int**)malloc(zoneToLevelPosLength*sizeof(int*));
+	for(int i=0;i<zoneToLevelPosLength;i++)
+		cTable[i] = (int*)malloc(zoneToLevelPosLength*sizeof(int));
 
 	// Store values on table
-	for(int i=0;i<zoneLength;i++)
+	for(int i=0;i<zoneToLevelPosLength;i++)
 	{
-		// Start to get 4 neighbours cell of this box position
-		//(level representation)
-		int boxPos = zonePos[i];
-		int* lNei = (int*)malloc(4*sizeof(int));
-		lNei[0] = boxPos - 1; // Left
-		lNei[1] = boxPos + 1; // Right
-		lNei[2] = boxPos - level->getColsNumber(); // Up
-		lNei[3] = boxPos + level->getColsNumber(); // Down
+		int boxPos = zoneToLevelPos[i];
 
 		// Create boxesZone with only 1box
 		Zone* newBoxesZone = new Zone(goalZone->getLength());
-		newBoxesZone->write1ToPos(levelToZonePos[zonePos[i]]);
+		newBoxesZone->write1ToPos(i);
 
 		// Create node with complete pusherZone
 		Zone* pusherZone = new Zone(goalZone->getLength());
@@ -603,34 +605,36 @@ int** BotBestPushesS::createCostTable()
 		Node* newNode = new Node(this, pusherZone, newBoxesZone);
 
 		// Compute solutions
-		DijkstraBox* dBox = new DijkstraBox(this, newNode, boxPos);
-		int* sol = dBox->resolvePositions();
-		delete dBox;
+		dijkstraBox->setBox(newNode, boxPos);
+		int* sol = dijkstraBox->resolvePositions();
 
-		for(int j=0;j<zoneLength;j++)
+		for(int j=0;j<zoneToLevelPosLength;j++)
 			cTable[i][j] = sol[j];
 
 		printf("costTable Initialization [%.0f%%]\n",
-				100/(float)zoneLength*i);
+				100/(float)zoneToLevelPosLength*i);
 
 		free(sol);
-		free(lNei);
 		delete newNode;
 	}
 
-	free(zonePos);
-
-	saveCostTable(cTable, zoneLength);
+	saveCostTable(cTable, zoneToLevelPosLength);
 
-	return cTable;
+	return createBoxRows(cTable);
 }
 
 int** BotBestPushesS::loadCostTable(char* fileName)
 {
-	int zoneLength;
+	int zoneLength = 0;
 	FILE* file = fopen(fileName, "r");
 
-	fscanf(file, "%d\n", &zoneLength);
+	// File of another level is created again
+	if(  fscanf(file, "%d\n", &zoneLength) != 1
+	  || zoneLength != zoneToLevelPosLength)
+	{
+		fclose(file);
+		return NULL;
+	}
 
 	int** cTable;
 	cTable = (int**)malloc(zoneLength*sizeof(int*));
@@ -648,6 +652,26 @@ int** BotBestPushesS::loadCostTable(char* fileName)
 
 	fclose(file);
 
+	return createBoxRows(cTable);
+}
+
+int** BotBestPushesS::createBoxRows(int** zoneTable) const
+{
+	int** cTable = (int**)malloc(boxToZonePosLength*sizeof(int*));
+	for(int i=0;i<boxToZonePosLength;i++)
+	{
+		cTable[i] = zoneTable[boxToZonePos[i]];
+		zoneTable[boxToZonePos[i]] = NULL;
+	}
+
+	// Rows of dead squares
+	for(int i=0;i<zoneToLevelPosLength;i++)
+	{
+		if(zoneTable[i])
+			free(zoneTable[i]);
+	}
+	free(zoneTable);
+
 	return cTable;
 }
 
@@ -696,6 +720,37 @@ void BotBestPushesS::saveCostTable(int** cTable, int zoneLength)
 	free(fileLine);
 }
 
+void BotBestPushesS::freezePackedBoxes(
+		BotBestPushesS_Matrix<double>* assignMatrix, const Zone* boxesZone,
+		const int* boxesPositions, const int* goalsPositions) const
+{
+	int packedNumber = goalRoom->getPackedNumber(boxesZone);
+	if(packedNumber == 0)
+		return;
+
+	int numOfBoxes = level->getBoxesNumber();
+	int numOfGoals = level->getGoalsNumber();
+	for(int i=0;i<numOfBoxes;i++)
+	{
+		if(!goalRoom->isPacked(boxesPositions[i], packedNumber))
+			continue;
+
+		// Box i can only use its goal and its goal can only be used by box i
+		for(int j=0;j<numOfGoals;j++)
+		{
+			if(goalsPositions[j] != boxesPositions[i])
+				continue;
+			for(int k=0;k<numOfGoals;k++)
+			{
+				if(k != i)
+					(*assignMatrix)(k,j) = 999999;
+				if(k != j)
+					(*assignMatrix)(i,k) = 999999;
+			}
+		}
+	}
+}
+
 BotBestPushesS_Matrix<double>*
 BotBestPushesS::createAssignationMatrix(const int* boxesPositions,
 		const int* goalsPositions) const
@@ -709,7 +764,7 @@ BotBestPushesS::createAssignationMatrix(const int* boxesPositions,
 	for(int i=0;i<numOfBoxes;i++)
 		for(int j=0;j<numOfGoals;j++)
 			(*assignMatrix)(i,j)
-				= costTable[boxesPositions[i]][goalsPositions[j]];
+				= getCost(boxesPositions[i], goalsPositions[j]);
 
 	// If there are less boxes than goals, we fill the rest with 999999
 	// (big factice value so it's used after all others box). we need a
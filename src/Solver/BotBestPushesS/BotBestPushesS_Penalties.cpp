@@ -8,6 +8,9 @@
 
 #include "../../../include/Solver/BotBestPushesS/BotBestPushesS_Penalties.h"
 
+pthread_mutex_t BotBestPushesS_Penalties::fileMutex =
+		PTHREAD_MUTEX_INITIALIZER;
+
 /* ------------*/
 /* Constructor */
 /* ------------*/
@@ -21,6 +24,7 @@ BotBestPushesS_Penalties::BotBestPushesS_Penalties(Solver* solver):
 	penaltiesTestTab(NULL),
 	penaltiesTestTabLength(0),
 	emptyLevel(NULL),
+	usedBoxesZone(NULL),
 	level(solver->getLevel()),
 	goalZone(solver->getGoalZone()),
 	zoneToLevelPos(solver->getZoneToLevelPos()),
@@ -41,6 +45,8 @@ BotBestPushesS_Penalties::BotBestPushesS_Penalties(Solver* solver):
 	}
 	emptyLevel->setBoxesNumber(0);
 
+	usedBoxesZone = new Zone(zoneToLevelPosLength);
+
 	// Init of penalties zone list (list of sub-zones with multiple boxes that
 	// create penalties not catchable by traditionnal methods)
 	// We use same number of boxes used for sub-zones than the one used for
@@ -72,6 +78,8 @@ BotBestPushesS_Penalties::~BotBestPushesS_Penalties()
 		free(penaltiesTestTab);
 	if(emptyLevel)
 		delete emptyLevel;
+	if(usedBoxesZone)
+		delete usedBoxesZone;
 }
 
 /* -------*/
@@ -86,10 +94,10 @@ int BotBestPushesS_Penalties::getPenaltyOfTreeNode(TreeNode* treeNode) const
 	for(int i=0;i<pLength;i++)
 		actualCellId[i] = 0;
 
-	// we create a markedzone with all boxes of treenode
+	// No box of treenode is penalized yet (usedBoxesZone is set to 0)
 	Zone* boxesZone = treeNode->getNode()->getBoxesZone();
 	Zone* pusherZone = treeNode->getNode()->getPusherZone();
-	Zone* markedZone = new Zone(boxesZone);
+	usedBoxesZone->clear();
 
 	// Compute total penalty for all boxes
 	int maximumPenalty = getMaxPenalty(actualCellId);
@@ -106,9 +114,11 @@ int BotBestPushesS_Penalties::getPenaltyOfTreeNode(TreeNode* treeNode) const
 				Zone* pPusherZone = pNodes[i][j]->getPusherZone();
 				Zone* pBoxesZone = pNodes[i][j]->getBoxesZone();
 
-				// If penalized boxes are all included in markedZone and
-				// treenode pusherZone is included in penalized pusherzone
-				if(    pBoxesZone->isIncludedIn(markedZone)
+				// If penalized boxes are all boxes of treenode not already
+				// penalized and treenode pusherZone is included in penalized
+				// pusherzone
+				if(    pBoxesZone->isIncludedIn(boxesZone)
+				    && pBoxesZone->andIsEmpty(usedBoxesZone)
 				    && pusherZone->isIncludedIn(pPusherZone))
 				{
 					if(pValues[i][j] == INT_MAX)
@@ -116,8 +126,8 @@ int BotBestPushesS_Penalties::getPenaltyOfTreeNode(TreeNode* treeNode) const
 					else
 						total += pValues[i][j];
 
-					// we remove those boxes from markedZone
-					markedZone->applyMinusWith(pBoxesZone);
+					// those boxes can't be penalized again
+					usedBoxesZone->applyOrWith(pBoxesZone);
 				}
 				actualCellId[i]++;
 			}
@@ -125,7 +135,6 @@ int BotBestPushesS_Penalties::getPenaltyOfTreeNode(TreeNode* treeNode) const
 		maximumPenalty = getMaxPenalty(actualCellId);
 	}
 
-	delete markedZone;
 	free(actualCellId);
 
 	return total;
@@ -198,7 +207,7 @@ bool BotBestPushesS_Penalties::penaltiesListTest(int* tab, int tabLength,
 			// 3.5. Test created treenode
 			const Deadlock* engine = solver->getDeadlockEngine();
 			bool dCorner = engine->deadlockedCorner(testTreeNode);
-			bool dZone = engine->deadlockedZone(testTreeNode, -1);
+			bool dZone = engine->deadlockedZone(testTreeNode);
 			bool deadlocked = dCorner || dZone;
 
 			for(int j=0;j<tabLength && !deadlocked;j++)
@@ -225,6 +234,7 @@ bool BotBestPushesS_Penalties::penaltiesListTest(int* tab, int tabLength,
 					prereq = solver->getDeadlockedBoxesSearch();
 				Solver* newSolver = new BotBestPushesS(base, testLevel, INT_MAX,
 						limitSize, 5, 5, -1, prereq, true);
+				newSolver->setLevelContext(solver->getLevelContext());
 				int estimatedCost = ((BotA*)newSolver)->getInitialCost();
 				delete newSolver;
 
@@ -234,6 +244,7 @@ bool BotBestPushesS_Penalties::penaltiesListTest(int* tab, int tabLength,
 					Solver* newSolver = new BotBestPushesS(base, testLevel,
 							startNodeLimit, limitSize, openTable, openTable/2,
 							estimatedCost, prereq, true);
+					newSolver->setLevelContext(solver->getLevelContext());
 //					BotIDA* newSolver = new BotIDA(base, testLevel, startNodeLimit,
 //							limitSize, openTable, openTable/2, prereq, true);
 					newSolver->resolve();
@@ -459,10 +470,15 @@ void BotBestPushesS_Penalties::initPenaltiesList(int numberOfBoxes)
 	char* fileLine = Util::generateRep(file);
 
 	// We don't create deadlock list with BotGoodPushesS (cycle)
-	if(Util::isThisFileExists(fileLine))
-	{
-		// Load existing list and complete until numberOfBoxes reached
+	pthread_mutex_lock(&fileMutex);
+	bool fileExists = Util::isThisFileExists(fileLine);
+	if(fileExists)
 		loadPenaltiesList(fileLine, numberOfBoxes);
+	pthread_mutex_unlock(&fileMutex);
+
+	if(fileExists)
+	{
+		// Complete loaded list until numberOfBoxes reached
 		if(numberOfBoxes != 0 && numberOfBoxes >= penaltiesTestTabLength)
 			createPenaltiesList(numberOfBoxes);
 	}
@@ -587,6 +603,7 @@ void BotBestPushesS_Penalties::savePenaltiesList()
 	strcpy(file[4], "penaltiesNodeList.dat");
 	char* fileLine = Util::generateRep(file);
 
+	pthread_mutex_lock(&fileMutex);
 	FILE* ffile = NULL;
 	ffile = fopen(fileLine, "w");
 
@@ -614,6 +631,7 @@ void BotBestPushesS_Penalties::savePenaltiesList()
 	}
 
 	fclose(ffile);
+	pthread_mutex_unlock(&fileMutex);
 
 	for(int i=0;i<5;i++)
 		free(file[i]);
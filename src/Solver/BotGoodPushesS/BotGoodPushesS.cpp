@@ -31,3 +31,13 @@ int BotGoodPushesS::g(TreeNode* treeNode, int pushCost) const
 {
 	return 0;
 }
+
+int BotGoodPushesS::getPushG(TreeNode* parentTreeNode, const Push* push) const
+{
+	return 0;
+}
+
+bool BotGoodPushesS::usesPackingOrder(void) const
+{
+	return true;
+}
@@ -0,0 +1,306 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotHDA/BotHDA.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotHDA::BotHDA(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
+		int threadNumber, int openTableSize, int closeTableSize,
+		int deadlockedBoxesSearch, bool onlyPushNumber, bool quickSearch):
+	base(base),
+	level(level),
+	nodeNumber(0),
+	maxNodeNumber(maxNodeNumber),
+	maxRamSize(maxRamSize),
+	threadNumber(threadNumber),
+	deadlockedBoxesSearch(deadlockedBoxesSearch),
+	onlyPushNumber(onlyPushNumber),
+	quickSearch(quickSearch),
+	stats(NULL),
+	workers(NULL),
+	boxesKeys(NULL),
+	pusherKeys(NULL),
+	keysLength(0),
+	bestCost(INT_MAX),
+	activity(0),
+	stopped(false),
+	ramChecking(false)
+{
+	OPENTABLE_SIZE = openTableSize;
+	CLOSETABLE_SIZE = closeTableSize;
+
+	if(this->threadNumber < 1)
+		this->threadNumber = 1;
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotHDA::~BotHDA()
+{
+	if(stats)
+		delete stats;
+
+	// Level context of first worker is used by other ones
+	if(workers)
+	{
+		for(int i=threadNumber-1;i>=0;i--)
+			delete workers[i];
+		free(workers);
+	}
+	if(boxesKeys)
+		free(boxesKeys);
+	if(pusherKeys)
+		free(pusherKeys);
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+void BotHDA::resolve(void)
+{
+	initWorkers();
+
+	// First node is solution or deadlocked
+	if(workers[0]->getSolved())
+	{
+		stats = new Stats(workers[0]->getStats());
+		return;
+	}
+
+	initKeys();
+
+	// Every worker is active until it has nothing to search
+	activity = threadNumber;
+	sendFirstNode();
+	runWorkers();
+
+	createStats();
+}
+
+int BotHDA::getOwner(const Node* node) const
+{
+	if(threadNumber == 1)
+		return 0;
+
+	// Pusher zone is represented by its first position
+	const Zone* boxesZone = node->getBoxesZone();
+	const Zone* pusherZone = node->getPusherZone();
+	unsigned int key = 0;
+	bool pusherFound = false;
+	for(int i=0;i<keysLength;i++)
+	{
+		if(boxesZone->readPos(i) == 1)
+			key ^= boxesKeys[i];
+		if(!pusherFound && pusherZone->readPos(i) == 1)
+		{
+			key ^= pusherKeys[i];
+			pusherFound = true;
+		}
+	}
+
+	return key%threadNumber;
+}
+
+void BotHDA::send(int owner, BotHDA_Message* message)
+{
+	// Counted before owner can receive it
+	addActivity(1);
+	workers[owner]->getQueue()->push(message);
+}
+
+bool BotHDA::offerSolution(int cost)
+{
+	int best = getBestCost();
+	while(cost < best)
+	{
+		if(__atomic_compare_exchange_n(&bestCost, &best, cost, false,
+				__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			return true;
+	}
+
+	return false;
+}
+
+bool BotHDA::countNode(void)
+{
+	int number = __atomic_add_fetch(&nodeNumber, 1, __ATOMIC_RELAXED);
+	if(number > maxNodeNumber)
+	{
+		__atomic_store_n(&stopped, true, __ATOMIC_RELEASE);
+		return false;
+	}
+
+	// Size of process is read by one worker at a time (first worker is only
+	// used to read it : its own ramSize is not used by its search)
+	if(   number%RAMCHECK_PERIOD == 0
+	   && !__atomic_exchange_n(&ramChecking, true, __ATOMIC_ACQUIRE))
+	{
+		int size = workers[0]->getSize();
+		__atomic_store_n(&ramChecking, false, __ATOMIC_RELEASE);
+		if(size > maxRamSize*1048576)
+		{
+			__atomic_store_n(&stopped, true, __ATOMIC_RELEASE);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void BotHDA::initWorkers(void)
+{
+	workers = (BotHDA_Worker**)malloc(threadNumber*sizeof(BotHDA_Worker*));
+	for(int i=0;i<threadNumber;i++)
+		workers[i] = new BotHDA_Worker(base, level, this, i, maxNodeNumber,
+				maxRamSize, OPENTABLE_SIZE, CLOSETABLE_SIZE,
+				deadlockedBoxesSearch, onlyPushNumber, quickSearch);
+
+	// Tables of the level are computed (or loaded) by first worker
+	workers[0]->start();
+	if(workers[0]->getSolved())
+		return;
+
+	for(int i=1;i<threadNumber;i++)
+	{
+		workers[i]->setLevelContext(workers[0]->getLevelContext());
+		workers[i]->start();
+	}
+}
+
+void BotHDA::initKeys(void)
+{
+	keysLength = workers[0]->getZoneToLevelPosLength();
+	boxesKeys = (unsigned int*)malloc(keysLength*sizeof(unsigned int));
+	pusherKeys = (unsigned int*)malloc(keysLength*sizeof(unsigned int));
+
+	// Same keys for every search (xorshift)
+	unsigned int random = 2463534242u;
+	for(int i=0;i<keysLength;i++)
+	{
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+		boxesKeys[i] = random;
+
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+		pusherKeys[i] = random;
+	}
+}
+
+void BotHDA::sendFirstNode(void)
+{
+	const TreeNode* root = workers[0]->getProcessingTreeRoot();
+	Node* node = root->getNode();
+	int owner = getOwner(node);
+
+	Node* ownerNode = new Node(workers[owner],
+			new Zone(node->getPusherZone()), new Zone(node->getBoxesZone()));
+	send(owner, new BotHDA_Message(ownerNode, 0,
+			((const BotA_TreeNode*)root)->getF(), NULL));
+}
+
+void BotHDA::runWorkers(void)
+{
+	pthread_t* threads = (pthread_t*)malloc(threadNumber*sizeof(pthread_t));
+	for(int i=0;i<threadNumber;i++)
+	{
+		if(pthread_create(&threads[i], NULL, BotHDA_Worker::run, workers[i])
+				!= 0)
+		{
+			printf("BotHDA :: impossible to create thread %d\n", i);
+			exit(-1);
+		}
+	}
+
+	for(int i=0;i<threadNumber;i++)
+		pthread_join(threads[i], NULL);
+
+	free(threads);
+}
+
+void BotHDA::createStats(void)
+{
+	// Worker of best solution
+	BotHDA_Worker* solutionWorker = NULL;
+	TreeNode* solutionTreeNode = NULL;
+	for(int i=0;i<threadNumber && !stopped;i++)
+	{
+		TreeNode* treeNode = workers[i]->getSolutionTreeNode();
+		if(treeNode && ((BotA_TreeNode*)treeNode)->getG() == bestCost)
+		{
+			solutionWorker = workers[i];
+			solutionTreeNode = treeNode;
+			break;
+		}
+	}
+
+	// A solution found before the limit is maybe not the best one
+	if(solutionTreeNode == NULL)
+	{
+		if(stopped)
+			stats = new Stats(base, workers[0], NULL, NULL, -1,
+				"Impossible to solve : Ram Limit or Max Nodes Limit reached");
+		else
+			stats = new Stats(base, workers[0], NULL, NULL, -1,
+				"Impossible to solve : No more nodes in waiting list");
+		return;
+	}
+
+	Path* path = NULL;
+	if(!onlyPushNumber)
+	{
+		// Parents of the solution are in many workers : copy them in a tree
+		int length = 0;
+		TreeNode* cur = solutionTreeNode;
+		while(cur != NULL)
+		{
+			length++;
+			cur = ((BotHDA_TreeNode*)cur)->getRemoteParent();
+		}
+
+		TreeNode** remoteTreeNodes = (TreeNode**)malloc(
+				length*sizeof(TreeNode*));
+		cur = solutionTreeNode;
+		for(int i=length-1;i>=0;i--)
+		{
+			remoteTreeNodes[i] = cur;
+			cur = ((BotHDA_TreeNode*)cur)->getRemoteParent();
+		}
+
+		TreeNode* firstTreeNode = new TreeNode(
+				new Node(remoteTreeNodes[0]->getNode()));
+		TreeNode* lastTreeNode = firstTreeNode;
+		for(int i=1;i<length;i++)
+		{
+			TreeNode* treeNode = new TreeNode(
+					new Node(remoteTreeNodes[i]->getNode()));
+			lastTreeNode->addChild(treeNode);
+			lastTreeNode = treeNode;
+		}
+		free(remoteTreeNodes);
+
+		path = lastTreeNode->getPath();
+		delete firstTreeNode;
+
+		if(!level->isSolution(path))
+		{
+			printf("BotHDA :: A solution is found but is wrong.\n");
+			printf("BotHDA :: Parents of treeNodes must be good but not ");
+			printf("treeNode::getPath()");
+			exit(-1);
+		}
+	}
+
+	stats = new Stats(base, solutionWorker, NULL, path, bestCost,
+			"Solution found");
+}
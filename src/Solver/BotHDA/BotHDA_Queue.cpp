@@ -0,0 +1,107 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotHDA/BotHDA_Queue.h"
+#include "../../../include/Solver/Node.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotHDA_Message::BotHDA_Message(Node* node, int g, int f,
+		TreeNode* remoteParent):
+	node(node),
+	g(g),
+	f(f),
+	remoteParent(remoteParent),
+	next(NULL)
+{
+
+}
+
+BotHDA_Queue::BotHDA_Queue():
+	head(NULL),
+	tail(NULL),
+	stub(NULL)
+{
+	stub = new BotHDA_Message(NULL, 0, 0, NULL);
+	head = stub;
+	tail = stub;
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotHDA_Message::~BotHDA_Message()
+{
+	// Node is set to NULL by a consumer that keeps it
+	if(node)
+		delete node;
+}
+
+BotHDA_Queue::~BotHDA_Queue()
+{
+	BotHDA_Message* message = pop();
+	while(message != NULL)
+	{
+		delete message;
+		message = pop();
+	}
+	delete stub;
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+void BotHDA_Queue::push(BotHDA_Message* message)
+{
+	__atomic_store_n(&message->next, (BotHDA_Message*)NULL, __ATOMIC_RELAXED);
+
+	// Message is linked to previous one after the exchange : until then,
+	// consumer sees the queue stopped at previous message
+	BotHDA_Message* previous = __atomic_exchange_n(&head, message,
+			__ATOMIC_ACQ_REL);
+	__atomic_store_n(&previous->next, message, __ATOMIC_RELEASE);
+}
+
+BotHDA_Message* BotHDA_Queue::pop(void)
+{
+	BotHDA_Message* first = tail;
+	BotHDA_Message* next = __atomic_load_n(&first->next, __ATOMIC_ACQUIRE);
+
+	// Skip stub
+	if(first == stub)
+	{
+		if(next == NULL)
+			return NULL;
+		tail = next;
+		first = next;
+		next = __atomic_load_n(&next->next, __ATOMIC_ACQUIRE);
+	}
+
+	if(next != NULL)
+	{
+		tail = next;
+		return first;
+	}
+
+	// A producer has exchanged head but not linked its message yet
+	BotHDA_Message* last = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+	if(first != last)
+		return NULL;
+
+	// Last message can only be popped with a message after it
+	push(stub);
+	next = __atomic_load_n(&first->next, __ATOMIC_ACQUIRE);
+	if(next != NULL)
+	{
+		tail = next;
+		return first;
+	}
+
+	return NULL;
+}
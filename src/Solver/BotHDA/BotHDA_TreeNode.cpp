@@ -0,0 +1,20 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotHDA/BotHDA_TreeNode.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotHDA_TreeNode::BotHDA_TreeNode(Node* node, const int f, const int g,
+		TreeNode* remoteParent)
+	: BotA_TreeNode(node, f, g),
+	  remoteParent(remoteParent)
+{
+
+}
@@ -0,0 +1,258 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include <sched.h>
+#include "../../../include/Solver/BotHDA/BotHDA_Worker.h"
+#include "../../../include/Solver/BotHDA/BotHDA.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotHDA_Worker::BotHDA_Worker(Base* base, Level* level, BotHDA* hda,
+		int workerId, int maxNodeNumber, int maxRamSize, int openTableSize,
+		int closeTableSize, int deadlockedBoxesSearch, bool onlyPushNumber,
+		bool quickSearch)
+	: BotBestPushesS(base, level, maxNodeNumber, maxRamSize, openTableSize,
+			closeTableSize, -1, deadlockedBoxesSearch, onlyPushNumber,
+			quickSearch),
+	  hda(hda),
+	  workerId(workerId),
+	  queue(NULL),
+	  solutionTreeNode(NULL)
+{
+	queue = new BotHDA_Queue();
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotHDA_Worker::~BotHDA_Worker()
+{
+	// TreeNodes are not in the tree of first node
+	if(openTable)
+		deleteTreeNodes(openTable);
+	if(closeTable)
+		deleteTreeNodes(closeTable);
+	delete queue;
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+void BotHDA_Worker::start(void)
+{
+	initialize();
+}
+
+void BotHDA_Worker::initStartingNode(void)
+{
+	if(workerId != 0)
+		return;
+
+	BotBestPushesS::initStartingNode();
+
+	// First node stays out of the tables of this worker
+	if(!solved)
+	{
+		closeNodeList->deleteFirstItem();
+		closeTable->removeItem(processingTreeRoot->getNode());
+	}
+}
+
+void* BotHDA_Worker::run(void* worker)
+{
+	((BotHDA_Worker*)worker)->process();
+	return NULL;
+}
+
+void BotHDA_Worker::process(void)
+{
+	bool active = true;
+
+	while(!hda->isStopped())
+	{
+		// Received nodes first : one of them can have a smaller f(x)
+		BotHDA_Message* message = queue->pop();
+		if(message != NULL)
+		{
+			receive(message);
+
+			// An inactive worker becomes active with the received node
+			if(active)
+				hda->addActivity(-1);
+			else
+				active = true;
+			continue;
+		}
+
+		TreeNode* treeNode = NULL;
+		if(active)
+			treeNode = nextTreeNode();
+
+		if(treeNode == NULL)
+		{
+			if(active)
+			{
+				active = false;
+				hda->addActivity(-1);
+			}
+			else if(hda->getActivity() == 0)
+				break;
+			else
+				sched_yield();
+			continue;
+		}
+
+		if(solutionNode(treeNode))
+		{
+			if(hda->offerSolution(((BotA_TreeNode*)treeNode)->getG()))
+				solutionTreeNode = treeNode;
+		}
+		else if(hda->countNode())
+			expand(treeNode);
+	}
+
+	solved = true;
+}
+
+TreeNode* BotHDA_Worker::nextTreeNode(void)
+{
+	ListNode* listNode = closeNodeList->getFirstItem();
+	if(listNode == NULL)
+		return NULL;
+
+	TreeNode* treeNode = listNode->getTreeNode();
+	delete listNode;
+
+	// Every waiting treeNode has a bigger or equal f(x)
+	if(((BotA_TreeNode*)treeNode)->getF() >= hda->getBestCost())
+		return NULL;
+
+	closeNodeList->deleteFirstItem();
+	closeTable->removeItem(treeNode->getNode());
+	openTable->addItem(treeNode);
+	nodeNumber++;
+
+	return treeNode;
+}
+
+void BotHDA_Worker::expand(TreeNode* treeNode)
+{
+	Child** children = findNodeChildren(treeNode->getNode(), pushes);
+	int bestCost = hda->getBestCost();
+
+	for(int i=0;children[i] != NULL;i++)
+	{
+		// Temporary child (to compute its cost and test deadlocks)
+		TreeNode* child = createTreeNode(children[i]->child, treeNode,
+				children[i]->childCost);
+		delete children[i];
+
+		int childF = ((BotA_TreeNode*)child)->getF();
+		int childG = ((BotA_TreeNode*)child)->getG();
+
+		if(  childF != INT_MAX && childF < bestCost
+		  && !deadlockEngine->deadlockedNode(child))
+		{
+			// Node of the owner (its tables and waiting list use its solver)
+			Node* node = child->getNode();
+			int owner = hda->getOwner(node);
+			Node* ownerNode = new Node(hda->getWorker(owner),
+					new Zone(node->getPusherZone()),
+					new Zone(node->getBoxesZone()));
+			BotHDA_Message* message = new BotHDA_Message(ownerNode, childG,
+					childF, treeNode);
+
+			if(owner == workerId)
+				receive(message);
+			else
+				hda->send(owner, message);
+		}
+
+		delete child;
+	}
+
+	free(children);
+}
+
+void BotHDA_Worker::receive(BotHDA_Message* message)
+{
+	Node* node = message->node;
+
+	// Every solution from this node is bigger than best one
+	if(message->f >= hda->getBestCost())
+	{
+		delete message;
+		return;
+	}
+
+	// Same node waiting : h(x) is kept, f(x) can only decrease
+	BotHDA_TreeNode* oldTreeNode =
+			(BotHDA_TreeNode*)closeTable->getTreeNodeFromNode(node);
+	if(oldTreeNode != NULL)
+	{
+		if(message->g < oldTreeNode->getG())
+		{
+			int h = oldTreeNode->getH();
+			oldTreeNode->setG(message->g);
+			oldTreeNode->setF(message->g + h);
+			oldTreeNode->setRemoteParent(message->remoteParent);
+
+			int heapStackCell =
+				((BotA_HashTable*)closeTable)->getHeapStackCell(node);
+			((BotA_HeapStack*)closeNodeList)->repositionCell(heapStackCell);
+		}
+
+		delete message;
+		return;
+	}
+
+	// Same node already expanded : it's searched again with smaller g(x)
+	oldTreeNode = (BotHDA_TreeNode*)openTable->getTreeNodeFromNode(node);
+	if(oldTreeNode != NULL)
+	{
+		if(message->g < oldTreeNode->getG())
+		{
+			int h = oldTreeNode->getH();
+			oldTreeNode->setG(message->g);
+			oldTreeNode->setF(message->g + h);
+			oldTreeNode->setRemoteParent(message->remoteParent);
+
+			openTable->removeItem(node);
+			closeTable->addItem(oldTreeNode);
+			addTreeNodeToCloseList(oldTreeNode);
+		}
+
+		delete message;
+		return;
+	}
+
+	TreeNode* treeNode = new BotHDA_TreeNode(node, message->f, message->g,
+			message->remoteParent);
+	message->node = NULL;
+	delete message;
+
+	closeTable->addItem(treeNode);
+	addTreeNodeToCloseList(treeNode);
+}
+
+void BotHDA_Worker::deleteTreeNodes(HashTable* table)
+{
+	ChainedList* const* cells = table->getTable();
+	int length = table->getLength();
+	for(int i=0;i<length;i++)
+	{
+		ListNode* cur = cells[i]->getFirstItem();
+		while(cur != NULL)
+		{
+			TreeNode* treeNode = cur->getTreeNode();
+			cur = cur->getNext();
+			delete treeNode;
+		}
+	}
+}
@@ -7,6 +7,9 @@
 /*----------------------------------------------*/
 
 #include "../../../include/Solver/BotIDA/BotIDA.h"
+#include "../../../include/Solver/BotIDA/BotIDA_Search.h"
+#include "../../../include/Solver/BotIDA/BotIDA_Fringe.h"
+#include "../../../include/Solver/BotIDA/BotIDA_Parallel.h"
 
 /* ------------*/
 /* Constructor */
@@ -22,11 +25,17 @@ BotIDA::BotIDA(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
 	deadlockedBoxesSearch(deadlockedBoxesSearch),
 	onlyPushNumber(onlyPushNumber),
 	quickSearch(quickSearch),
-	stats(NULL)
-
+	stats(NULL),
+	verdictCache(NULL),
+	thresholdGrowth(THRESHOLD_GROWTH),
+	fringeSearch(false),
+	threadNumber(1)
 {
 	OPENTABLE_SIZE = openTableSize;
 	CLOSETABLE_SIZE = closeTableSize;
+
+	verdictCache = new VerdictCache(Deadlock::VERDICTCACHE_SIZE,
+			Deadlock::VERDICTCACHE_MAXITEMS);
 }
 
 /* -----------*/
@@ -36,6 +45,8 @@ BotIDA::~BotIDA()
 {
 	if(stats)
 		delete stats;
+	if(verdictCache)
+		delete verdictCache;
 }
 
 /* -------*/
@@ -45,19 +56,38 @@ void BotIDA::resolve()
 {
 	bool solved = alreadySolved();
 
-	// Get initial cost to start with
-	int cost = initInitialCost();
-
 	char* message = (char*)malloc(255*sizeof(char));
 	message = strcpy(message, "starting...");
 
+	// Same search (level tables and transposition table or fringe) for every
+	// iteration
+	BotIDA_Search* solver = NULL;
+	int cost = 0;
+	if(!solved)
+	{
+		if(fringeSearch)
+			solver = new BotIDA_Fringe(base, level, maxNodeNumber,
+					maxRamSize, OPENTABLE_SIZE, CLOSETABLE_SIZE,
+					deadlockedBoxesSearch, onlyPushNumber, quickSearch);
+		else if(threadNumber > 1)
+			solver = new BotIDA_Parallel(base, level, maxNodeNumber,
+					maxRamSize, threadNumber, deadlockedBoxesSearch,
+					onlyPushNumber, quickSearch);
+		else
+			solver = new BotIDA_Search(base, level, maxNodeNumber,
+					maxRamSize, deadlockedBoxesSearch, onlyPushNumber,
+					quickSearch);
+		solver->setVerdictCache(verdictCache);
+
+		// Get initial cost to start with
+		cost = initInitialCost(solver);
+	}
+
 	// While solution's not found or limit not reached, we keep trying
 	while(!solved && notFinished(message))
 	{
 		printf("cost : %d\n", cost);
-		Solver* solver = new BotBestPushesS(base, level, maxNodeNumber,
-				maxRamSize,	OPENTABLE_SIZE, CLOSETABLE_SIZE, cost,
-				deadlockedBoxesSearch, onlyPushNumber, quickSearch);
+		solver->setCostLimit(cost);
 		solver->resolve();
 
 		nodeNumber += solver->getNodeNumber();
@@ -68,30 +98,29 @@ void BotIDA::resolve()
 			solver->getStats()->print("solutions.txt");
 		}
 
-		int newCost = ((BotA*)solver)->getMinReject();
-		if(newCost <= cost)
-		{
-			delete solver;
-			break;
-		}
-		else
-			cost = newCost;
-
 		message = strcpy(message, solver->getStats()->getMessage());
 
 		bool solutionIsFound = solutionFound(message);
 
+		// Solution of a search under the cost limit can have a smaller
+		// smallest rejected f(x)
+		int newCost = solver->getNextCostLimit(thresholdGrowth);
+		if(newCost <= cost && notFinished(message))
+			break;
+		else
+			cost = newCost;
+
 		if(!onlyPushNumber && solutionIsFound)
 			saveSolution(solver);
 		else if(!onlyPushNumber && notLimited(message))
-			saveInitialCost(cost);
+			saveInitialCost(solver->getLowerBound());
 
 		if(solved || !notFinished(message))
 			stats = new Stats(solver->getStats());
-
-		delete solver;
 	}
 
+	if(solver)
+		delete solver;
 	free(message);
 }
 
@@ -110,7 +139,10 @@ bool BotIDA::notFinished(char* message) const
 				"Impossible to solve : Ram Limit or Max Nodes Limit reached")
 					!= 0
 	  && strcmp(message, "Solution found : first node is solution") != 0
-	  && strcmp(message, "Solution found") != 0);
+	  && strcmp(message, "Solution found") != 0
+	  && strcmp(message,
+				"Solution found : limit reached before proving it's the best")
+					!= 0);
 }
 
 bool BotIDA::solutionFound(char* message) const
@@ -189,7 +221,7 @@ bool BotIDA::alreadySolved()
 	return alreadySolved;
 }
 
-int BotIDA::initInitialCost()
+int BotIDA::initInitialCost(BotIDA_Search* solver)
 {
 	const char* packName = level->getPackName();
 	int levelId = level->getId();
@@ -211,9 +243,13 @@ int BotIDA::initInitialCost()
 
 	int cost;
 	if(Util::isThisFileExists(fileLine) && !onlyPushNumber)
+	{
+		// Saved cost is the smallest possible solution
 		cost = loadInitialCost(fileLine);
+		solver->setLowerBound(cost);
+	}
 	else
-		cost = createInitialCost();
+		cost = createInitialCost(solver);
 
 	for(int i=0;i<5;i++)
 		free(file[i]);
@@ -223,14 +259,11 @@ int BotIDA::initInitialCost()
 	return cost;
 }
 
-int BotIDA::createInitialCost()
+int BotIDA::createInitialCost(BotIDA_Search* solver)
 {
-	int cost = 0;
-
-	Solver* initSolver = new BotBestPushesS(base, level, 0,
-			maxRamSize, 1, 1, -1, deadlockedBoxesSearch, true);
-	cost = ((BotA*)initSolver)->getInitialCost();
-	delete initSolver;
+	// First node of the search (level tables are computed once for every
+	// iteration)
+	int cost = solver->getRootCost();
 
 	if(!onlyPushNumber)
 		saveInitialCost(cost);
@@ -0,0 +1,68 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotIDA/BotIDA_ConcurrentTable.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotIDA_ConcurrentTable::BotIDA_ConcurrentTable(int length, int numberCell):
+	BotIDA_TranspositionTable(length, numberCell),
+	locks(NULL)
+{
+	locks = (pthread_mutex_t*)malloc(LOCKS_NUMBER*sizeof(pthread_mutex_t));
+	if(!locks)
+	{
+		printf("BotIDA_ConcurrentTable :: not enough memory\n");
+		exit(-1);
+	}
+
+	for(int i=0;i<LOCKS_NUMBER;i++)
+		pthread_mutex_init(&locks[i], NULL);
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotIDA_ConcurrentTable::~BotIDA_ConcurrentTable()
+{
+	for(int i=0;i<LOCKS_NUMBER;i++)
+		pthread_mutex_destroy(&locks[i]);
+	free(locks);
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+bool BotIDA_ConcurrentTable::find(const Node* node, int* iteration, int* g,
+		int* h)
+{
+	int cell = this->h(node);
+	pthread_mutex_t* lock = &locks[cell%LOCKS_NUMBER];
+
+	pthread_mutex_lock(lock);
+	bool found = findCell(cell, node, iteration, g, h);
+	pthread_mutex_unlock(lock);
+
+	return found;
+}
+
+void BotIDA_ConcurrentTable::store(const Node* node, int iteration, int g,
+		int h)
+{
+	int cell = this->h(node);
+	pthread_mutex_t* lock = &locks[cell%LOCKS_NUMBER];
+
+	pthread_mutex_lock(lock);
+	bool empty = storeCell(cell, node, iteration, g, h);
+	pthread_mutex_unlock(lock);
+
+	// Cells of other groups are used at the same time
+	if(empty)
+		__atomic_add_fetch(&itemNumber, 1, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,141 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotIDA/BotIDA_Deque.h"
+#include "../../../include/Solver/Zone.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotIDA_Task::BotIDA_Task(int length, int g, int f):
+	pusherZones(NULL),
+	boxesZones(NULL),
+	length(length),
+	g(g),
+	f(f)
+{
+	pusherZones = (Zone**)malloc(length*sizeof(Zone*));
+	boxesZones = (Zone**)malloc(length*sizeof(Zone*));
+	for(int i=0;i<length;i++)
+	{
+		pusherZones[i] = NULL;
+		boxesZones[i] = NULL;
+	}
+}
+
+BotIDA_Deque::BotIDA_Deque(int capacity):
+	tasks(NULL),
+	capacity(capacity),
+	top(0),
+	bottom(0)
+{
+	tasks = (BotIDA_Task**)malloc(capacity*sizeof(BotIDA_Task*));
+	for(int i=0;i<capacity;i++)
+		tasks[i] = NULL;
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotIDA_Task::~BotIDA_Task()
+{
+	// Zones are set to NULL by a worker that keeps them
+	for(int i=0;i<length;i++)
+	{
+		if(pusherZones[i])
+			delete pusherZones[i];
+		if(boxesZones[i])
+			delete boxesZones[i];
+	}
+	free(pusherZones);
+	free(boxesZones);
+}
+
+BotIDA_Deque::~BotIDA_Deque()
+{
+	BotIDA_Task* task = pop();
+	while(task != NULL)
+	{
+		delete task;
+		task = pop();
+	}
+	free(tasks);
+}
+
+/* --------*/
+/* Getters */
+/* --------*/
+bool BotIDA_Deque::isEmpty(void)
+{
+	long b = __atomic_load_n(&bottom, __ATOMIC_RELAXED);
+	long t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+
+	return b <= t;
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+bool BotIDA_Deque::push(BotIDA_Task* task)
+{
+	long b = __atomic_load_n(&bottom, __ATOMIC_RELAXED);
+	long t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+	if(b - t >= capacity)
+		return false;
+
+	// Task is written before thieves can see the new bottom
+	__atomic_store_n(&tasks[b%capacity], task, __ATOMIC_RELAXED);
+	__atomic_store_n(&bottom, b+1, __ATOMIC_RELEASE);
+
+	return true;
+}
+
+BotIDA_Task* BotIDA_Deque::pop(void)
+{
+	long b = __atomic_load_n(&bottom, __ATOMIC_RELAXED) - 1;
+	__atomic_store_n(&bottom, b, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	long t = __atomic_load_n(&top, __ATOMIC_RELAXED);
+
+	if(t > b)
+	{
+		// Empty
+		__atomic_store_n(&bottom, b+1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+
+	BotIDA_Task* task = __atomic_load_n(&tasks[b%capacity], __ATOMIC_RELAXED);
+	if(t == b)
+	{
+		// Last task : a thief can take it at the same time
+		if(!__atomic_compare_exchange_n(&top, &t, t+1, false,
+				__ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+			task = NULL;
+		__atomic_store_n(&bottom, b+1, __ATOMIC_RELAXED);
+	}
+
+	return task;
+}
+
+BotIDA_Task* BotIDA_Deque::steal(void)
+{
+	long t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	long b = __atomic_load_n(&bottom, __ATOMIC_ACQUIRE);
+
+	if(t >= b)
+		return NULL;
+
+	// Owner or another thief can take it first
+	BotIDA_Task* task = __atomic_load_n(&tasks[t%capacity], __ATOMIC_RELAXED);
+	if(!__atomic_compare_exchange_n(&top, &t, t+1, false, __ATOMIC_SEQ_CST,
+			__ATOMIC_RELAXED))
+		return NULL;
+
+	return task;
+}
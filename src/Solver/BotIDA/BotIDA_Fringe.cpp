@@ -0,0 +1,113 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotIDA/BotIDA_Fringe.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotIDA_Fringe::BotIDA_Fringe(Base* base, Level* level, int maxNodeNumber,
+		int maxRamSize, int openTableSize, int closeTableSize,
+		int deadlockedBoxesSearch, bool onlyPushNumber, bool quickSearch)
+	: BotIDA_Search(base, level, maxNodeNumber, maxRamSize,
+			deadlockedBoxesSearch, onlyPushNumber, quickSearch)
+{
+	OPENTABLE_SIZE = openTableSize;
+	CLOSETABLE_SIZE = closeTableSize;
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+int BotIDA_Fringe::getNextCostLimit(int /*nodeGrowth*/) const
+{
+	// Kept treeNodes are not searched again : no need of bigger steps
+	return minReject;
+}
+
+void BotIDA_Fringe::initHashTable(void)
+{
+	BotA::initHashTable();
+	fringeTable = new HashTable(CLOSETABLE_SIZE);
+}
+
+void BotIDA_Fringe::initTranspositionTable(void)
+{
+}
+
+void BotIDA_Fringe::process(void)
+{
+	nodeNumber = 0;
+	iterationNumber++;
+
+	// First node is already in the waiting list of first iteration
+	releaseFringe();
+	BotA::process();
+
+	if(stats->getNumOfPushes() >= 0)
+	{
+		finished = true;
+		return;
+	}
+
+	// Every solution is bigger than kept and rejected treeNodes
+	if(  strcmp(stats->getMessage(),
+			"Impossible to solve : No more nodes in waiting list") == 0
+	  && minReject > lowerBound)
+		lowerBound = minReject;
+}
+
+void BotIDA_Fringe::releaseFringe(void)
+{
+	minReject = INT_MAX;
+
+	int itemNumber = fringeTable->getItemNumber();
+	if(itemNumber == 0)
+		return;
+
+	// Copy kept treeNodes before modifying the table
+	TreeNode** keptTreeNodes = (TreeNode**)malloc(
+			itemNumber*sizeof(TreeNode*));
+	int keptNumber = 0;
+	ChainedList* const* table = fringeTable->getTable();
+	int length = fringeTable->getLength();
+	for(int i=0;i<length;i++)
+	{
+		ListNode* cur = table[i]->getFirstItem();
+		while(cur != NULL)
+		{
+			keptTreeNodes[keptNumber] = cur->getTreeNode();
+			keptNumber++;
+			cur = cur->getNext();
+		}
+	}
+
+	for(int i=0;i<keptNumber;i++)
+	{
+		TreeNode* treeNode = keptTreeNodes[i];
+		int f = ((BotA_TreeNode*)treeNode)->getF();
+		if(f > costLimit)
+		{
+			if(f < minReject)
+				minReject = f;
+			continue;
+		}
+
+		// Kept treeNodes are not tested for deadlocks until they are used
+		fringeTable->removeItem(treeNode->getNode());
+		if(deadlockEngine->deadlockedNode(treeNode))
+			delete treeNode;
+		else
+		{
+			closeTable->addItem(treeNode);
+			addTreeNodeToCloseList(treeNode);
+		}
+	}
+
+	free(keptTreeNodes);
+}
@@ -0,0 +1,170 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotIDA/BotIDA_Parallel.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotIDA_Parallel::BotIDA_Parallel(Base* base, Level* level, int maxNodeNumber,
+		int maxRamSize, int threadNumber, int deadlockedBoxesSearch,
+		bool onlyPushNumber, bool quickSearch)
+	: BotIDA_Search(base, level, maxNodeNumber, maxRamSize,
+			deadlockedBoxesSearch, onlyPushNumber, quickSearch),
+	  threadNumber(threadNumber),
+	  workers(NULL),
+	  workersInitialized(false),
+	  pendingNumber(0),
+	  idleNumber(0),
+	  cancelled(false),
+	  limitReached(false),
+	  solutionWorker(NULL)
+{
+	if(this->threadNumber < 1)
+		this->threadNumber = 1;
+
+	workers = (BotIDA_ParallelWorker**)malloc(
+			this->threadNumber*sizeof(BotIDA_ParallelWorker*));
+	for(int i=0;i<this->threadNumber;i++)
+		workers[i] = new BotIDA_ParallelWorker(base, level, this, i,
+				maxNodeNumber, maxRamSize, deadlockedBoxesSearch,
+				onlyPushNumber, quickSearch);
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotIDA_Parallel::~BotIDA_Parallel()
+{
+	// Level context and transposition table of this solver are used by
+	// workers
+	for(int i=0;i<threadNumber;i++)
+		delete workers[i];
+	free(workers);
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+bool BotIDA_Parallel::countNode(void)
+{
+	if(isCancelled())
+		return false;
+
+	int number = __atomic_add_fetch(&nodeNumber, 1, __ATOMIC_RELAXED);
+	if(number > maxNodeNumber)
+	{
+		__atomic_store_n(&limitReached, true, __ATOMIC_RELAXED);
+		__atomic_store_n(&cancelled, true, __ATOMIC_RELEASE);
+		return false;
+	}
+
+	return true;
+}
+
+void BotIDA_Parallel::offerSolution(BotIDA_ParallelWorker* worker)
+{
+	BotIDA_ParallelWorker* noWorker = NULL;
+	__atomic_compare_exchange_n(&solutionWorker, &noWorker, worker, false,
+			__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	__atomic_store_n(&cancelled, true, __ATOMIC_RELEASE);
+}
+
+void BotIDA_Parallel::initTranspositionTable(void)
+{
+	transpositionTable = new BotIDA_ConcurrentTable(
+			TRANSPOSITIONTABLE_SIZE,
+			processingTreeRoot->getNode()->getBoxesZone()->getNumberCell());
+}
+
+void BotIDA_Parallel::searchFirstNode(void)
+{
+	if(!workersInitialized)
+		initWorkers();
+
+	pendingNumber = 0;
+	idleNumber = 0;
+	cancelled = false;
+	limitReached = false;
+	solutionWorker = NULL;
+	for(int i=0;i<threadNumber;i++)
+		workers[i]->startIteration(costLimit, iterationNumber);
+
+	// First node is the first task of first worker
+	workers[0]->pushTask(processingTreeRoot);
+	runWorkers();
+
+	gatherWorkers();
+}
+
+void BotIDA_Parallel::initWorkers(void)
+{
+	// Files of deadlocks and penalties are already created by this solver
+	for(int i=0;i<threadNumber;i++)
+	{
+		workers[i]->setLevelContext(levelContext);
+		workers[i]->initWorker();
+	}
+	workersInitialized = true;
+}
+
+void BotIDA_Parallel::runWorkers(void)
+{
+	pthread_t* threads = (pthread_t*)malloc(threadNumber*sizeof(pthread_t));
+	for(int i=0;i<threadNumber;i++)
+	{
+		if(pthread_create(&threads[i], NULL, BotIDA_ParallelWorker::run,
+				workers[i]) != 0)
+		{
+			printf("BotIDA_Parallel :: impossible to create thread %d\n", i);
+			exit(-1);
+		}
+	}
+
+	for(int i=0;i<threadNumber;i++)
+		pthread_join(threads[i], NULL);
+
+	free(threads);
+}
+
+void BotIDA_Parallel::gatherWorkers(void)
+{
+	for(int i=0;i<threadNumber;i++)
+	{
+		BotIDA_ParallelWorker* worker = workers[i];
+		if(worker->getMinReject() < minReject)
+			minReject = worker->getMinReject();
+
+		const int* histogram = worker->getRejectHistogram();
+		for(int j=0;j<REJECTHISTOGRAM_SIZE;j++)
+			rejectHistogram[j] += histogram[j];
+
+		// Tasks not searched by a cancelled iteration
+		BotIDA_Task* task = worker->getDeque()->pop();
+		while(task != NULL)
+		{
+			delete task;
+			task = worker->getDeque()->pop();
+		}
+	}
+
+	// A solution found after the limit of nodes is kept
+	if(solutionWorker != NULL)
+	{
+		const Stats* solutionStats = solutionWorker->getStats();
+		Path* path = NULL;
+		if(solutionStats->getSolutionPath() != NULL)
+			path = new Path(base, solutionStats->getSolutionPath());
+
+		solved = true;
+		stats = new Stats(base, this, NULL, path,
+				solutionStats->getNumOfPushes(), "Solution found");
+	}
+	else if(limitReached)
+		stopped = true;
+}
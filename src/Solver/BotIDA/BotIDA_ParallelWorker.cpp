@@ -0,0 +1,262 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include <sched.h>
+#include "../../../include/Solver/BotIDA/BotIDA_ParallelWorker.h"
+#include "../../../include/Solver/BotIDA/BotIDA_Parallel.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotIDA_ParallelWorker::BotIDA_ParallelWorker(Base* base, Level* level,
+		BotIDA_Parallel* parallel, int workerId, int maxNodeNumber,
+		int maxRamSize, int deadlockedBoxesSearch, bool onlyPushNumber,
+		bool quickSearch)
+	: BotIDA_Search(base, level, maxNodeNumber, maxRamSize,
+			deadlockedBoxesSearch, onlyPushNumber, quickSearch),
+	  parallel(parallel),
+	  workerId(workerId),
+	  deque(NULL),
+	  random(2463534242u + workerId)
+{
+	// Children of one treeNode are pushed only when deque is empty
+	deque = new BotIDA_Deque(4*level->getBoxesNumber()+1);
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotIDA_ParallelWorker::~BotIDA_ParallelWorker()
+{
+	// Transposition table is deleted by parallel
+	transpositionTable = NULL;
+	delete deque;
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+void BotIDA_ParallelWorker::initWorker(void)
+{
+	initialize();
+	transpositionTable = parallel->getTranspositionTable();
+}
+
+void BotIDA_ParallelWorker::startIteration(int costLimit, int iterationNumber)
+{
+	this->costLimit = costLimit;
+	this->iterationNumber = iterationNumber;
+	nodeNumber = 0;
+	minReject = INT_MAX;
+	for(int i=0;i<REJECTHISTOGRAM_SIZE;i++)
+		rejectHistogram[i] = 0;
+
+	if(stats)
+	{
+		delete stats;
+		stats = NULL;
+	}
+	solved = false;
+	stopped = false;
+}
+
+void* BotIDA_ParallelWorker::run(void* worker)
+{
+	((BotIDA_ParallelWorker*)worker)->process();
+	return NULL;
+}
+
+void BotIDA_ParallelWorker::initStartingNode(void)
+{
+
+}
+
+void BotIDA_ParallelWorker::process(void)
+{
+	bool idle = false;
+	BotIDA_Task* task = deque->pop();
+
+	while(!parallel->isCancelled())
+	{
+		if(task == NULL)
+			task = stealTask();
+
+		if(task == NULL)
+		{
+			// Every task of the iteration is searched
+			if(parallel->getPendingNumber() == 0)
+				break;
+
+			if(!idle)
+			{
+				idle = true;
+				parallel->addIdleNumber(1);
+			}
+			sched_yield();
+			continue;
+		}
+
+		if(idle)
+		{
+			idle = false;
+			parallel->addIdleNumber(-1);
+		}
+
+		searchTask(task);
+		parallel->addPendingNumber(-1);
+		task = deque->pop();
+	}
+
+	if(idle)
+		parallel->addIdleNumber(-1);
+}
+
+int BotIDA_ParallelWorker::depthFirst(TreeNode* treeNode)
+{
+	// Solution or limit of nodes found by a worker
+	if(!parallel->countNode())
+	{
+		stopped = true;
+		return INT_MAX;
+	}
+
+	return BotIDA_Search::depthFirst(treeNode);
+}
+
+int BotIDA_ParallelWorker::searchChildren(TreeNode** children, int number)
+{
+	int minValue = INT_MAX;
+
+	// Pushed from last to first : this worker pops them in h(x) order, idle
+	// workers steal children with biggest h(x) first
+	if(number > 1 && parallel->getIdleNumber() > 0 && deque->isEmpty())
+	{
+		int searchedNumber = number;
+		for(int i=number-1;i>0 && pushTask(children[i]);i--)
+		{
+			int childF = ((BotA_TreeNode*)children[i])->getF();
+			if(childF < minValue)
+				minValue = childF;
+			delete children[i];
+			searchedNumber = i;
+		}
+		number = searchedNumber;
+	}
+
+	int value = BotIDA_Search::searchChildren(children, number);
+	if(value < minValue)
+		minValue = value;
+
+	return minValue;
+}
+
+bool BotIDA_ParallelWorker::pushTask(TreeNode* treeNode)
+{
+	// Nodes from first node are only needed to build the path of a solution
+	int length = 1;
+	if(!onlyPushNumber)
+	{
+		TreeNode* cur = treeNode->getParent();
+		while(cur != NULL)
+		{
+			length++;
+			cur = cur->getParent();
+		}
+	}
+
+	BotIDA_Task* task = new BotIDA_Task(length,
+			((BotA_TreeNode*)treeNode)->getG(),
+			((BotA_TreeNode*)treeNode)->getF());
+	TreeNode* cur = treeNode;
+	for(int i=length-1;i>=0;i--)
+	{
+		task->pusherZones[i] = new Zone(cur->getNode()->getPusherZone());
+		task->boxesZones[i] = new Zone(cur->getNode()->getBoxesZone());
+		cur = cur->getParent();
+	}
+
+	// Counted before another worker can search it
+	parallel->addPendingNumber(1);
+	if(!deque->push(task))
+	{
+		parallel->addPendingNumber(-1);
+		delete task;
+		return false;
+	}
+
+	return true;
+}
+
+void BotIDA_ParallelWorker::searchTask(BotIDA_Task* task)
+{
+	// Nodes of the task are created for this worker (nodes use tables of
+	// their solver)
+	TreeNode* firstTreeNode = NULL;
+	TreeNode* treeNode = NULL;
+	for(int i=0;i<task->length;i++)
+	{
+		Node* node = new Node(this, task->pusherZones[i],
+				task->boxesZones[i]);
+		task->pusherZones[i] = NULL;
+		task->boxesZones[i] = NULL;
+
+		TreeNode* newTreeNode;
+		if(i == task->length-1)
+			newTreeNode = new BotA_TreeNode(node, task->f, task->g);
+		else
+			newTreeNode = new TreeNode(node);
+
+		if(treeNode)
+			treeNode->addChild(newTreeNode);
+		else
+			firstTreeNode = newTreeNode;
+		treeNode = newTreeNode;
+	}
+	delete task;
+
+	// Same node can be searched by another worker with a smaller g(x) since
+	// it was pushed
+	bool searched;
+	int f = getTranspositionF(treeNode, &searched);
+	((BotA_TreeNode*)treeNode)->setF(f);
+	if(!searched && f <= costLimit)
+	{
+		depthFirst(treeNode);
+		if(solved)
+			parallel->offerSolution(this);
+	}
+	else if(!searched)
+		addReject(f);
+
+	// Path of a solution is kept in stats
+	delete firstTreeNode;
+}
+
+BotIDA_Task* BotIDA_ParallelWorker::stealTask(void)
+{
+	int threadNumber = parallel->getThreadNumber();
+
+	// Thieves don't all begin with the same worker (xorshift)
+	random ^= random << 13;
+	random ^= random >> 17;
+	random ^= random << 5;
+	int first = random%threadNumber;
+
+	for(int i=0;i<threadNumber;i++)
+	{
+		int victim = (first+i)%threadNumber;
+		if(victim == workerId)
+			continue;
+
+		BotIDA_Task* task = parallel->getWorker(victim)->getDeque()->steal();
+		if(task != NULL)
+			return task;
+	}
+
+	return NULL;
+}
@@ -0,0 +1,359 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotIDA/BotIDA_Search.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotIDA_Search::BotIDA_Search(Base* base, Level* level, int maxNodeNumber,
+		int maxRamSize, int deadlockedBoxesSearch, bool onlyPushNumber,
+		bool quickSearch)
+	: BotBestPushesS(base, level, maxNodeNumber, maxRamSize, 1, 1, -1,
+			deadlockedBoxesSearch, onlyPushNumber, quickSearch),
+	  transpositionTable(NULL),
+	  iterationNumber(0),
+	  finished(false),
+	  lowerBound(0),
+	  rejectHistogram(NULL)
+{
+	rejectHistogram = (int*)malloc(REJECTHISTOGRAM_SIZE*sizeof(int));
+	for(int i=0;i<REJECTHISTOGRAM_SIZE;i++)
+		rejectHistogram[i] = 0;
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotIDA_Search::~BotIDA_Search()
+{
+	if(transpositionTable)
+		delete transpositionTable;
+	free(rejectHistogram);
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+void BotIDA_Search::resolve(void)
+{
+	start();
+	if(finished)
+		return;
+
+	if(stats)
+	{
+		delete stats;
+		stats = NULL;
+	}
+	solved = false;
+
+	if(maxNodeNumber > 0)
+		process();
+}
+
+int BotIDA_Search::getNextCostLimit(int nodeGrowth) const
+{
+	if(nodeGrowth <= 100 || minReject == INT_MAX)
+		return minReject;
+
+	// Rejected nodes under next cost limit are searched (at least) in
+	// next iteration : smallest limit with enough new nodes
+	long long target = (long long)nodeNumber*(nodeGrowth-100)/100;
+	long long sum = 0;
+	int lastBucket = 0;
+	for(int i=0;i<REJECTHISTOGRAM_SIZE;i++)
+	{
+		if(rejectHistogram[i] == 0)
+			continue;
+
+		sum += rejectHistogram[i];
+		lastBucket = i;
+		if(sum >= target)
+			break;
+	}
+
+	int nextCostLimit = costLimit + 1 + lastBucket;
+	if(nextCostLimit < minReject)
+		nextCostLimit = minReject;
+
+	return nextCostLimit;
+}
+
+int BotIDA_Search::getRootCost(void)
+{
+	start();
+	return ((BotA_TreeNode*)processingTreeRoot)->getF();
+}
+
+void BotIDA_Search::start(void)
+{
+	if(processingTreeRoot != NULL)
+		return;
+
+	initialize();
+	initTranspositionTable();
+
+	int rootF = ((BotA_TreeNode*)processingTreeRoot)->getF();
+	if(rootF > lowerBound)
+		lowerBound = rootF;
+
+	// First node is solution or deadlocked
+	if(solved)
+		finished = true;
+}
+
+void BotIDA_Search::initTranspositionTable(void)
+{
+	transpositionTable = new BotIDA_TranspositionTable(
+			TRANSPOSITIONTABLE_SIZE,
+			processingTreeRoot->getNode()->getBoxesZone()->getNumberCell());
+}
+
+void BotIDA_Search::process(void)
+{
+	nodeNumber = 0;
+	stopped = false;
+	search();
+
+	// Cost limit can be bigger than the smallest possible solution : search
+	// again under the found solution until no smaller one exists. Each
+	// search has its own limit of nodes.
+	Stats* bestStats = NULL;
+	int searchedNodeNumber = 0;
+	while(solved && stats->getNumOfPushes() > lowerBound)
+	{
+		if(bestStats)
+			delete bestStats;
+		bestStats = stats;
+		stats = NULL;
+		solved = false;
+
+		searchedNodeNumber += nodeNumber;
+		nodeNumber = 0;
+		costLimit = bestStats->getNumOfPushes() - 1;
+		search();
+	}
+	nodeNumber += searchedNodeNumber;
+
+	// Found solution is the best one, or the last one found before the
+	// limit (not proven to be the best one)
+	if(bestStats && !solved && !stopped)
+	{
+		stats = bestStats;
+		bestStats = NULL;
+		solved = true;
+	}
+	else if(bestStats && !solved)
+	{
+		solved = true;
+		Path* path = NULL;
+		if(bestStats->getSolutionPath())
+			path = new Path(base, bestStats->getSolutionPath());
+		stats = new Stats(base, this, NULL, path, bestStats->getNumOfPushes(),
+				"Solution found : limit reached before proving it's the best");
+	}
+	if(bestStats)
+		delete bestStats;
+
+	if(solved)
+	{
+		finished = true;
+		return;
+	}
+
+	solved = true;
+	if(stopped)
+		stats = new Stats(base, this, NULL, NULL, -1,
+				"Impossible to solve : Ram Limit or Max Nodes Limit reached");
+	else
+		stats = new Stats(base, this, NULL, NULL, -1,
+				"Impossible to solve : No more nodes in waiting list");
+}
+
+void BotIDA_Search::search(void)
+{
+	iterationNumber++;
+	minReject = INT_MAX;
+	for(int i=0;i<REJECTHISTOGRAM_SIZE;i++)
+		rejectHistogram[i] = 0;
+
+	// Root can have a bigger h(x) found by previous iteration
+	bool searched;
+	int rootF = getTranspositionF(processingTreeRoot, &searched);
+	((BotA_TreeNode*)processingTreeRoot)->setF(rootF);
+	if(rootF > lowerBound)
+		lowerBound = rootF;
+
+	if(rootF > costLimit)
+		addReject(rootF);
+	else
+		searchFirstNode();
+
+	// Every solution is bigger than rejected nodes
+	if(!solved && !stopped && minReject > lowerBound)
+		lowerBound = minReject;
+}
+
+void BotIDA_Search::searchFirstNode(void)
+{
+	depthFirst(processingTreeRoot);
+}
+
+int BotIDA_Search::depthFirst(TreeNode* treeNode)
+{
+	nodeNumber++;
+
+	if(testSolution(treeNode))
+	{
+		solved = true;
+		return 0;
+	}
+
+	if(nodeNumber > maxNodeNumber)
+	{
+		stopped = true;
+		return INT_MAX;
+	}
+
+	printInfos(treeNode);
+
+	int g = ((BotA_TreeNode*)treeNode)->getG();
+	int h = ((BotA_TreeNode*)treeNode)->getH();
+	transpositionTable->store(treeNode->getNode(), iterationNumber, g, h);
+
+	// Keep children under cost limit, sorted by h(x) (like BotA_HeapStack
+	// with a cost limit)
+	Child** children = findNodeChildren(treeNode->getNode(), pushes);
+	int childNumber = 0;
+	while(children[childNumber] != NULL)
+		childNumber++;
+
+	TreeNode** keptChildren = (TreeNode**)malloc(
+			(childNumber+1)*sizeof(TreeNode*));
+	int* keptH = (int*)malloc((childNumber+1)*sizeof(int));
+	int keptNumber = 0;
+	int minValue = INT_MAX;
+
+	for(int i=0;i<childNumber;i++)
+	{
+		TreeNode* child = createTreeNode(children[i]->child, treeNode,
+				children[i]->childCost);
+		delete children[i];
+
+		bool searched;
+		int childF = getTranspositionF(child, &searched);
+		((BotA_TreeNode*)child)->setF(childF);
+
+		// Rejected or already searched in this iteration (rejected children
+		// of a searched one are already counted with its smaller g(x))
+		if(childF > costLimit || searched)
+		{
+			if(!searched && childF > costLimit)
+				addReject(childF);
+			if(childF < minValue)
+				minValue = childF;
+			delete child;
+		}
+		else if(deadlockEngine->deadlockedNode(child))
+			delete child;
+		else
+		{
+			int childH = ((BotA_TreeNode*)child)->getH();
+			int j = keptNumber;
+			while(j > 0 && keptH[j-1] > childH)
+			{
+				keptChildren[j] = keptChildren[j-1];
+				keptH[j] = keptH[j-1];
+				j--;
+			}
+			keptChildren[j] = child;
+			keptH[j] = childH;
+			keptNumber++;
+		}
+	}
+	free(children);
+
+	int value = searchChildren(keptChildren, keptNumber);
+	if(value < minValue)
+		minValue = value;
+	free(keptChildren);
+	free(keptH);
+
+	// Smallest rejected f(x) of sub-tree gives a bigger h(x) for next
+	// iterations
+	if(!solved && !stopped)
+	{
+		int learnedH = INT_MAX;
+		if(minValue != INT_MAX)
+			learnedH = minValue - g;
+		if(learnedH > h)
+			transpositionTable->store(treeNode->getNode(), iterationNumber, g,
+					learnedH);
+	}
+
+	return minValue;
+}
+
+int BotIDA_Search::searchChildren(TreeNode** children, int number)
+{
+	int minValue = INT_MAX;
+
+	// Treenodes of the solution are kept in the tree
+	for(int i=0;i<number;i++)
+	{
+		if(!solved && !stopped)
+		{
+			int value = depthFirst(children[i]);
+			if(value < minValue)
+				minValue = value;
+		}
+
+		if(!solved)
+			delete children[i];
+	}
+
+	return minValue;
+}
+
+int BotIDA_Search::getTranspositionF(TreeNode* treeNode, bool* searched)
+{
+	int f = ((BotA_TreeNode*)treeNode)->getF();
+	int g = ((BotA_TreeNode*)treeNode)->getG();
+	*searched = false;
+
+	int iteration, oldG, oldH;
+	if(  f == INT_MAX
+	  || !transpositionTable->find(treeNode->getNode(), &iteration, &oldG,
+			  &oldH))
+		return f;
+
+	// Same node with a smaller g(x) (or on actual path)
+	if(iteration == iterationNumber && oldG <= g)
+		*searched = true;
+
+	if(oldH == INT_MAX)
+		return INT_MAX;
+	if(g + oldH > f)
+		return g + oldH;
+	return f;
+}
+
+void BotIDA_Search::addReject(int f)
+{
+	if(f < minReject)
+		minReject = f;
+
+	if(f != INT_MAX)
+	{
+		int bucket = f - costLimit - 1;
+		if(bucket >= REJECTHISTOGRAM_SIZE)
+			bucket = REJECTHISTOGRAM_SIZE - 1;
+		rejectHistogram[bucket]++;
+	}
+}
@@ -0,0 +1,133 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../../include/Solver/BotIDA/BotIDA_TranspositionTable.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+BotIDA_TranspositionTable::BotIDA_TranspositionTable(int length,
+		int numberCell):
+	length(length),
+	keyLength(2*numberCell),
+	keys(NULL),
+	iterations(NULL),
+	gValues(NULL),
+	hValues(NULL),
+	itemNumber(0)
+{
+	keys = (unsigned int*)malloc(length*keyLength*sizeof(unsigned int));
+	iterations = (int*)malloc(length*sizeof(int));
+	gValues = (int*)malloc(length*sizeof(int));
+	hValues = (int*)malloc(length*sizeof(int));
+
+	if(!keys || !iterations || !gValues || !hValues)
+	{
+		printf("BotIDA_TranspositionTable :: not enough memory\n");
+		exit(-1);
+	}
+
+	for(int i=0;i<length;i++)
+		iterations[i] = 0;
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+BotIDA_TranspositionTable::~BotIDA_TranspositionTable()
+{
+	free(keys);
+	free(iterations);
+	free(gValues);
+	free(hValues);
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+bool BotIDA_TranspositionTable::find(const Node* node, int* iteration,
+		int* g, int* h)
+{
+	return findCell(this->h(node), node, iteration, g, h);
+}
+
+void BotIDA_TranspositionTable::store(const Node* node, int iteration, int g,
+		int h)
+{
+	if(storeCell(this->h(node), node, iteration, g, h))
+		itemNumber++;
+}
+
+bool BotIDA_TranspositionTable::findCell(int cell, const Node* node,
+		int* iteration, int* g, int* h)
+{
+	if(iterations[cell] == 0 || !sameKey(cell, node))
+		return false;
+
+	*iteration = iterations[cell];
+	*g = gValues[cell];
+	*h = hValues[cell];
+	return true;
+}
+
+bool BotIDA_TranspositionTable::storeCell(int cell, const Node* node,
+		int iteration, int g, int h)
+{
+	bool empty = (iterations[cell] == 0);
+	if(!empty && !sameKey(cell, node))
+	{
+		// Replace by depth : keep node of biggest sub-tree
+		if(iterations[cell] == iteration && gValues[cell] < g)
+			return false;
+	}
+
+	int numberCell = keyLength/2;
+	unsigned int* cellKey = &keys[cell*keyLength];
+	memcpy(cellKey, node->getBoxesZone()->getZoneTab(),
+			numberCell*sizeof(unsigned int));
+	memcpy(&cellKey[numberCell], node->getPusherZone()->getZoneTab(),
+			numberCell*sizeof(unsigned int));
+	iterations[cell] = iteration;
+	gValues[cell] = g;
+	hValues[cell] = h;
+
+	return empty;
+}
+
+bool BotIDA_TranspositionTable::sameKey(int cell, const Node* node) const
+{
+	int numberCell = keyLength/2;
+	const unsigned int* cellKey = &keys[cell*keyLength];
+
+	return
+		(  memcmp(cellKey, node->getBoxesZone()->getZoneTab(),
+				numberCell*sizeof(unsigned int)) == 0
+		&& memcmp(&cellKey[numberCell], node->getPusherZone()->getZoneTab(),
+				numberCell*sizeof(unsigned int)) == 0);
+}
+
+int BotIDA_TranspositionTable::h(const Node* node) const
+{
+	// Same hash than a key of boxes then pusher zone
+	int numberCell = keyLength/2;
+	const unsigned int* boxesTab = node->getBoxesZone()->getZoneTab();
+	const unsigned int* pusherTab = node->getPusherZone()->getZoneTab();
+	unsigned int sum = 2166136261u;
+	for(int i=0;i<numberCell;i++)
+	{
+		sum ^= boxesTab[i];
+		sum *= 16777619u;
+	}
+	for(int i=0;i<numberCell;i++)
+	{
+		sum ^= pusherTab[i];
+		sum *= 16777619u;
+	}
+
+	return sum%length;
+}
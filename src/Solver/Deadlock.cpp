@@ -8,6 +8,7 @@
 
 #include "../../include/Solver/Deadlock.h"
 #include "../../include/Solver/BotGoodPushesS/BotGoodPushesS.h"
+#include "../../include/Solver/DijkstraBox.h"
 
 /* ------------*/
 /* Constructor */
@@ -16,21 +17,39 @@ Deadlock::Deadlock(Solver* solver):
 	base(solver->getBase()),
 	solver(solver),
 	deadlockZone(NULL),
+	predicateZone(NULL),
 	deadlockNodeList(NULL),
 	deadlockNodeListLength(0),
-	deadlockTestTab(NULL),
-	deadlockTestTabLength(0),
+	deadlockListBoxes(1),
+	deadlockIndexTab(NULL),
+	deadlockIndexLengths(NULL),
+	deadlockListFileName(NULL),
 	emptyLevel(NULL),
+	patternTab(NULL),
+	patternStates(NULL),
+	goalReachTab(NULL),
+	goalReachDone(NULL),
+	matchBoxTab(NULL),
+	matchGoalTab(NULL),
+	checkCalls(NULL),
+	checkHits(NULL),
+	checkTimes(NULL),
+	checkOrder(NULL),
+	checkEnabled(NULL),
+	checkOrderCountdown(CHECK_ORDER_PERIOD),
 	level(solver->getLevel()),
 	goalZone(solver->getGoalZone()),
 	zoneToLevelPos(solver->getZoneToLevelPos()),
 	zoneToLevelPosLength(solver->getZoneToLevelPosLength()),
-	levelToZonePos(solver->getLevelToZonePos())
+	levelToZonePos(solver->getLevelToZonePos()),
+	zoneToBoxPos(solver->getZoneToBoxPos()),
+	boxToZonePos(solver->getBoxToZonePos()),
+	boxToZonePosLength(solver->getBoxToZonePosLength())
 {
 	// Init of deadlock zone (if a box is on a marked position of this zone,
 	// state of level is deadlocked)
-	deadlockZone = new Zone(level, levelToZonePos, zoneToLevelPos,
-			zoneToLevelPosLength, Zone::PROCESS_DEADLOCK);
+	deadlockZone = new Zone(solver->getDeadSquareZone());
+	predicateZone = new Zone(zoneToLevelPosLength);
 
 	// Create empty level (without boxes or pusher)
 	emptyLevel = new Level(base, this->level);
@@ -46,9 +65,56 @@ Deadlock::Deadlock(Solver* solver):
 	}
 	emptyLevel->setBoxesNumber(0);
 
-	// Init of deadlock zone list (list of zones with multiple boxes that
-	// create deadlocks not catchable by traditionnal methods)
-//	initDeadlockList(solver->getDeadlockedBoxesSearch());
+	// Init of local patterns table (each pattern is searched when first met)
+	if(boxToZonePosLength < 0)
+	{
+		printf("Deadlock : invalid box index space\n");
+		exit(-1);
+	}
+	size_t patternTabLength = (size_t)boxToZonePosLength*PATTERN_NUMBER;
+	patternTab = (unsigned char*)malloc(
+			patternTabLength*sizeof(unsigned char));
+	for(size_t i=0;i<patternTabLength;i++)
+		patternTab[i] = PATTERN_UNKNOWN;
+	patternStates = (unsigned char*)malloc(
+			2*PATTERN_NUMBER*PATTERN_WINDOW*PATTERN_WINDOW
+			*sizeof(unsigned char));
+
+	// Init of goals matching (reachable goals are computed when first used)
+	int goalsNumber = level->getGoalsNumber();
+	goalReachTab = (bool*)malloc(
+			boxToZonePosLength*goalsNumber*sizeof(bool));
+	goalReachDone = (bool*)malloc(boxToZonePosLength*sizeof(bool));
+	matchBoxTab = (int*)malloc(boxToZonePosLength*sizeof(int));
+	for(int i=0;i<boxToZonePosLength;i++)
+	{
+		goalReachDone[i] = false;
+		matchBoxTab[i] = -1;
+	}
+	matchGoalTab = (int*)malloc(goalsNumber*sizeof(int));
+	for(int i=0;i<goalsNumber;i++)
+		matchGoalTab[i] = -1;
+
+	// Init of checks counters (first order is the fixed order of tests)
+	checkCalls = (long long*)malloc(CHECK_NUMBER*sizeof(long long));
+	checkHits = (long long*)malloc(CHECK_NUMBER*sizeof(long long));
+	checkTimes = (long long*)malloc(CHECK_NUMBER*sizeof(long long));
+	checkOrder = (int*)malloc(CHECK_NUMBER*sizeof(int));
+	checkEnabled = (bool*)malloc(CHECK_NUMBER*sizeof(bool));
+	for(int i=0;i<CHECK_NUMBER;i++)
+	{
+		checkCalls[i] = 0;
+		checkHits[i] = 0;
+		checkTimes[i] = 0;
+		checkOrder[i] = i;
+		checkEnabled[i] = true;
+	}
+
+	// Init of deadlock node list (list of nodes with multiple boxes that
+	// create deadlocks not catchable by traditionnal methods). Not created
+	// for solvers of tests (cycle)
+	if(!solver->getOnlyPushNumber())
+		initDeadlockList(solver->getDeadlockedBoxesSearch());
 }
 
 /* -----------*/
@@ -58,6 +124,8 @@ Deadlock::~Deadlock()
 {
 	if(deadlockZone)
 		delete deadlockZone;
+	if(predicateZone)
+		delete predicateZone;
 	if(deadlockNodeList)
 	{
 		int i=0;
@@ -68,10 +136,41 @@ Deadlock::~Deadlock()
 		}
 		free(deadlockNodeList);
 	}
-	if(deadlockTestTab)
-		free(deadlockTestTab);
+	if(deadlockIndexTab)
+	{
+		for(int i=0;i<boxToZonePosLength;i++)
+			if(deadlockIndexTab[i])
+				free(deadlockIndexTab[i]);
+		free(deadlockIndexTab);
+	}
+	if(deadlockIndexLengths)
+		free(deadlockIndexLengths);
+	if(deadlockListFileName)
+		free(deadlockListFileName);
 	if(emptyLevel)
 		delete emptyLevel;
+	if(patternTab)
+		free(patternTab);
+	if(patternStates)
+		free(patternStates);
+	if(goalReachTab)
+		free(goalReachTab);
+	if(goalReachDone)
+		free(goalReachDone);
+	if(matchBoxTab)
+		free(matchBoxTab);
+	if(matchGoalTab)
+		free(matchGoalTab);
+	if(checkCalls)
+		free(checkCalls);
+	if(checkHits)
+		free(checkHits);
+	if(checkTimes)
+		free(checkTimes);
+	if(checkOrder)
+		free(checkOrder);
+	if(checkEnabled)
+		free(checkEnabled);
 }
 
 /* -------*/
@@ -79,12 +178,114 @@ Deadlock::~Deadlock()
 /* -------*/
 bool Deadlock::deadlockedNode(TreeNode* treenode) const
 {
-	if(simpleDeadlock(treenode))
+	// First node : every check in fixed order
+	if(treenode->getPushedBoxPostPosition() == -1 || DEADLOCK_FULLTEST)
+	{
+		if(simpleDeadlock(treenode))
+			return true;
+		else if(deadlockedMatching(treenode))
+			return true;
+		else if(complexDeadlock(treenode))
+			return true;
+		else
+			return false;
+	}
+
+	checkOrderCountdown--;
+	if(checkOrderCountdown == 0)
+	{
+		sortChecks();
+		checkOrderCountdown = CHECK_ORDER_PERIOD;
+	}
+
+	for(int i=0;i<CHECK_NUMBER;i++)
+	{
+		int check = checkOrder[i];
+		if(checkEnabled[check] && measuredCheck(check, treenode))
+			return true;
+	}
+
+	return false;
+}
+
+bool Deadlock::deadlockedPush(const Zone* boxesZone, int posBox) const
+{
+	if(   checkEnabled[CHECK_CORNER]
+	   && deadlockZone->readPos(levelToZonePos[posBox]) == 1)
 		return true;
-	else if(complexDeadlock(treenode))
+
+	if(   checkEnabled[CHECK_LASTMOVE]
+	   && isDeadlockedPattern(posBox, createPatternMask(boxesZone, posBox)))
 		return true;
-	else
-		return false;
+
+	if(checkEnabled[CHECK_FROZEN])
+	{
+		Zone* wallZone = new Zone(zoneToLevelPosLength);
+		bool offGoal = false;
+		bool frozen = isFrozenBox(posBox, boxesZone, wallZone, &offGoal,
+				FROZENBOX_DEEPNESS);
+		delete wallZone;
+
+		// Frozen boxes all on goals are not a deadlock
+		if(frozen && offGoal)
+			return true;
+	}
+
+	return false;
+}
+
+const char* Deadlock::getCheckName(int check)
+{
+	switch(check)
+	{
+		case CHECK_CORNER : return "corner";
+		case CHECK_LASTMOVE : return "pattern";
+		case CHECK_FROZEN : return "frozen";
+		case CHECK_LIST : return "list";
+		case CHECK_MATCHING : return "matching";
+		case CHECK_ZONE : return "zone";
+		default : return "unknown";
+	}
+}
+
+bool Deadlock::deadlockedMatching(const TreeNode* treenode) const
+{
+	Zone* boxesZone = treenode->getNode()->getBoxesZone();
+	int goalsNumber = level->getGoalsNumber();
+
+	// Boxes of last matching that moved lose their goal
+	for(int i=0;i<goalsNumber;i++)
+	{
+		int pos = matchGoalTab[i];
+		if(pos != -1 && boxesZone->readPos(boxToZonePos[pos]) == 0)
+		{
+			matchBoxTab[pos] = -1;
+			matchGoalTab[i] = -1;
+		}
+	}
+
+	// Each unmatched box needs an augmenting path to a goal
+	bool* visitedGoal = (bool*)malloc(goalsNumber*sizeof(bool));
+	bool deadlocked = false;
+	for(int i=0;i<zoneToLevelPosLength && !deadlocked;i++)
+	{
+		if(boxesZone->readPos(i) == 0)
+			continue;
+
+		// Box on a dead square can't reach any goal
+		int boxPos = zoneToBoxPos[i];
+		if(boxPos == -1)
+			deadlocked = true;
+		else if(matchBoxTab[boxPos] == -1)
+		{
+			for(int j=0;j<goalsNumber;j++)
+				visitedGoal[j] = false;
+			deadlocked = !augmentMatching(boxPos, visitedGoal);
+		}
+	}
+	free(visitedGoal);
+
+	return deadlocked;
 }
 
 bool Deadlock::deadlockedLastMove(const TreeNode* treenode, int posBox) const
@@ -92,270 +293,651 @@ bool Deadlock::deadlockedLastMove(const TreeNode* treenode, int posBox) const
 	if(posBox == -2)
 		posBox = treenode->getPushedBoxPostPosition();
 
-	// If it's not first node and not in a goal position
+	// If it's not first node
 	if(posBox != -1)
 	{
-		// ========================
-		// Last move made a square
-		// ========================
-
-		int n = level->getColsNumber();
-
-		// neighbours positions
-		int posLeft =  levelToZonePos[posBox - 1];
-		int posRight = levelToZonePos[posBox + 1];
-		int posDown =  levelToZonePos[posBox + n];
-		int posUp =    levelToZonePos[posBox - n];
-
-		int posUpLeft =    levelToZonePos[posBox - n - 1];
-		int posDownLeft =  levelToZonePos[posBox + n - 1];
-		int posUpRight =   levelToZonePos[posBox - n + 1];
-		int posDownRight = levelToZonePos[posBox + n + 1];
-
-		// neighbours goals status
-		int goalBox = goalZone->readPos(levelToZonePos[posBox]);
-		int goalLeft = -1;
-		int goalRight = -1;
-		int goalDown = -1;
-		int goalUp = -1;
-
-		if(posLeft != -1)
-			goalLeft = goalZone->readPos(posLeft);
-		if(posRight != -1)
-			goalRight = goalZone->readPos(posRight);
-		if(posDown != -1)
-			goalDown = goalZone->readPos(posDown);
-		if(posUp != -1)
-			goalUp = goalZone->readPos(posUp);
-
-		Zone * boxesZone = treenode->getNode()->getBoxesZone();
-
-		// up-right square
-		if(		(posUp == -1 || boxesZone->readPos(posUp) == 1)
-			&&  (posUpRight == -1 || boxesZone->readPos(posUpRight) == 1)
-			&&  (posRight == -1 || boxesZone->readPos(posRight) == 1))
-		{
-			// If box or one of concerned neighbours is not on goal, we block
-			if(goalBox == 0 || goalUp == 0 || goalRight == 0)
-				return true;
-		}
+		int mask = createPatternMask(treenode->getNode()->getBoxesZone(),
+				posBox);
+		return isDeadlockedPattern(posBox, mask);
+	}
 
-		// up-left square
-		if(		(posUp == -1 || boxesZone->readPos(posUp) == 1)
-			&&  (posUpLeft == -1 || boxesZone->readPos(posUpLeft) == 1)
-			&&  (posLeft == -1 || boxesZone->readPos(posLeft) == 1))
-		{
-			// If box or one of concerned neighbours is not on goal, we block
-			if(goalBox == 0 || goalUp == 0 || goalLeft == 0)
-				return true;
-		}
+	return false;
+}
 
-		// down-right square
-		if(		(posDown == -1 || boxesZone->readPos(posDown) == 1)
-			&&  (posDownRight == -1 || boxesZone->readPos(posDownRight) == 1)
-			&&  (posRight == -1 || boxesZone->readPos(posRight) == 1))
-		{
-			// If box or one of concerned neighbours is not on goal, we block
-			if(goalBox == 0 || goalDown == 0 || goalRight == 0)
-				return true;
-		}
+bool Deadlock::deadlockedFrozen(const TreeNode* treenode, int posBox) const
+{
+	if(posBox == -2)
+		posBox = treenode->getPushedBoxPostPosition();
 
-		// down-left square
-		if(		(posDown == -1 || boxesZone->readPos(posDown) == 1)
-			&&  (posDownLeft == -1 || boxesZone->readPos(posDownLeft) == 1)
-			&&  (posLeft == -1 || boxesZone->readPos(posLeft) == 1))
-		{
-			// If box or one of concerned neighbours is not on goal, we block
-			if(goalBox == 0 || goalDown == 0 || goalLeft == 0)
-				return true;
-		}
+	// First node : no box has been pushed
+	if(posBox == -1)
+		return false;
 
-		// ===================
-		// Last move made a Z
-		// ===================
-		// * Z deadlock :
-		// * #####   #####   ######   ######
-		// * #   #   #   #   # #  #   #  # #
-		// * ##O #   # O##   # OO #   # OO #
-		// * # O##   ##O #   #  # #   # #  #
-		// * #   #   #   #   ######   ######
-		// * #####   #####
-
-		// fig 1, upper box
-		if(posLeft == -1 && posDownRight == -1
-				&& boxesZone->readPos(posDown) == 1)
-			if(goalBox == 0 || goalDown == 0)
-				return true;
+	Zone* wallZone = new Zone(zoneToLevelPosLength);
+	bool offGoal = false;
 
-		// fig 1, lower box
-		if(posRight == -1 && posUpLeft == -1
-				&& boxesZone->readPos(posUp) == 1)
-			if(goalBox == 0 || goalUp == 0)
-				return true;
+	bool frozen = isFrozenBox(posBox, treenode->getNode()->getBoxesZone(),
+			wallZone, &offGoal, FROZENBOX_DEEPNESS);
 
-		// fig 2, upper box
-		if(posRight == -1 && posDownLeft == -1
-				&& boxesZone->readPos(posDown) == 1)
-			if(goalBox == 0 || goalDown == 0)
-				return true;
+	delete wallZone;
 
-		// fig 2, lower box
-		if(posLeft == -1 && posUpRight == -1
-				&& boxesZone->readPos(posUp) == 1)
-			if(goalBox == 0 || goalUp == 0)
-				return true;
+	// Frozen boxes all on goals are not a deadlock
+	return (frozen && offGoal);
+}
 
-		// fig 3, left box
-		if(posUp == -1 && posDownRight == -1
-				&& boxesZone->readPos(posRight) == 1)
-			if(goalBox == 0 || goalRight == 0)
-				return true;
+bool Deadlock::deadlockedCorner(const TreeNode* treenode) const
+{
+	int posBox = treenode->getPushedBoxPostPosition();
 
-		// fig 3, right box
-		if(posDown == -1 && posUpLeft == -1
-				&& boxesZone->readPos(posLeft) == 1)
-			if(goalBox == 0 || goalLeft == 0)
-				return true;
+	// Only last pushed box can be on a new deadlock cell
+	if(posBox != -1 && !DEADLOCK_FULLTEST)
+		return (deadlockZone->readPos(levelToZonePos[posBox]) == 1);
 
-		// fig 4, left box
-		if(posDown == -1 && posUpRight == -1
-				&& boxesZone->readPos(posRight) == 1)
-			if(goalBox == 0 || goalRight == 0)
-				return true;
+	// A box is on a deadlock cell
+	return treenode->getNode()->getBoxesZone()->intersects(deadlockZone);
+}
+
+bool Deadlock::deadlockedList(const TreeNode* treenode) const
+{
+	if(deadlockNodeListLength == 0)
+		return false;
 
-		// fig 4, right box
-		if(posUp == -1 && posDownLeft == -1
-				&& boxesZone->readPos(posLeft) == 1)
-			if(goalBox == 0 || goalLeft == 0)
+	Zone* boxesZone = treenode->getNode()->getBoxesZone();
+	Zone* pusherZone = treenode->getNode()->getPusherZone();
+	int posBox = treenode->getPushedBoxPostPosition();
+
+	// First node : every position is tested
+	if(posBox == -1 || DEADLOCK_FULLTEST)
+	{
+		for(int i=0;i<deadlockNodeListLength;i++)
+		{
+			if(   deadlockNodeList[i]->getBoxesZone()->isIncludedIn(boxesZone)
+			   && pusherZone->isIncludedIn(
+					   deadlockNodeList[i]->getPusherZone()))
 				return true;
+		}
+		return false;
+	}
+
+	// Only positions with last pushed box
+	int pos = zoneToBoxPos[levelToZonePos[posBox]];
+	if(pos == -1)
+		return false;
+	for(int i=0;i<deadlockIndexLengths[pos];i++)
+	{
+		Node* node = deadlockNodeList[deadlockIndexTab[pos][i]];
+		if(   node->getBoxesZone()->isIncludedIn(boxesZone)
+		   && pusherZone->isIncludedIn(node->getPusherZone()))
+			return true;
 	}
 
 	return false;
 }
 
-bool Deadlock::deadlockedCorner(const TreeNode* treenode) const
+void Deadlock::deadlockListTest(int* tab, int tabLength)
 {
-	bool ret;
-	// A box is on a deadlock cell
-	Zone* test = new Zone(treenode->getNode()->getBoxesZone(),
-			deadlockZone, Zone::USE_AND);
-	if(!test->isFullOf0())
-		ret = true;
-	else
-		ret = false;
+	int nCols = level->getColsNumber();
 
-	delete test;
+	// Boxes on a deadlock cell are already catched
+	Zone* boxesZone = new Zone(zoneToLevelPosLength);
+	for(int i=0;i<tabLength;i++)
+		boxesZone->write1ToPos(tab[i]);
+	if(boxesZone->intersects(deadlockZone) || boxesZone->isIncludedIn(goalZone))
+	{
+		delete boxesZone;
+		return;
+	}
 
-	return ret;
+	// For each region of pusher around boxes
+	Zone* markedZone = new Zone(boxesZone);
+	for(int i=0;i<zoneToLevelPosLength;i++)
+	{
+		if(markedZone->readPos(i))
+			continue;
+
+		Node* testNode = new Node(solver);
+		testNode->setBoxesZone(new Zone(boxesZone));
+		testNode->setPusherZone(new Zone(boxesZone, zoneToLevelPos[i],
+				levelToZonePos, nCols));
+		markedZone->applyOrWith(testNode->getPusherZone());
+		TreeNode* testTreeNode = new TreeNode(testNode);
+
+		// Position already catched by others tests
+		bool deadlocked = deadlockedList(testTreeNode);
+		for(int j=0;j<tabLength && !deadlocked;j++)
+		{
+			deadlocked = deadlockedLastMove(testTreeNode,
+					zoneToLevelPos[tab[j]])
+			          || deadlockedFrozen(testTreeNode,
+					zoneToLevelPos[tab[j]]);
+		}
+
+		if(!deadlocked && searchBoxes(testNode, NULL, DEADLOCKLIST_MAXNODES))
+			addToDeadlockList(new Node(testNode));
+
+		delete testTreeNode;
+	}
+
+	delete boxesZone;
+	delete markedZone;
 }
 
-bool Deadlock::deadlockedZone(TreeNode* treenode, int maxN) const
+bool Deadlock::deadlockedZone(TreeNode* treenode) const
 {
-	Zone* boxesZone = treenode->getNode()->getBoxesZone();
-	Zone* pusherZone = treenode->getNode()->getPusherZone();
+	const Node* node = treenode->getNode();
+	Zone* boxesZone = node->getBoxesZone();
 
 	// Level representation of box position
 	int levelPosBox = treenode->getPushedBoxPostPosition();
 
-	int zonePosBox;
+	// No zone test for first node
 	if(levelPosBox == -1)
-	{
-		zonePosBox = -1;
-		maxN = 1;
-	}
-	else
-		zonePosBox = levelToZonePos[levelPosBox];
-
-	// Creation of tab of all empty zones except the ones with pusher
-	Zone** zone1Tab = createZone1Tab(boxesZone, pusherZone);
-
-	// If maxN = -1, we assign maximum number of possible junction to maxN
-	if(maxN == -1)
-		for(maxN=0;zone1Tab[maxN] != NULL;maxN++);
-
-	// Creation of a tab (maxN cells) of chained lists with zones
-	ZoneList** zoneListTab = (ZoneList**)malloc((maxN+1)*sizeof(ZoneList*));
-	for(int i=0;i<maxN;i++)
-		zoneListTab[i] = NULL;
-	zoneListTab[maxN] = NULL;
-
-	// If no parent node, we only test every zone1Tab
-//	if(levelPosBox == -1)
-//	{
-//		int i=0;
-//		while(zone1Tab[i] != NULL)
-//		{
-//			zoneListTab[0] = new ZoneList(new Zone(zone1Tab[i]),
-//					zoneListTab[0]);
-//			i++;
-//		}
-//	}
+		return false;
 
-	// Get all empty neighbours positions of last moved box (8 positions)
-	int* neiTab = createNeighboursTab(boxesZone, levelPosBox);
+	// Creation of tab of all corrals (empty zones except the ones with pusher)
+	Zone** zone1Tab = createZone1Tab(boxesZone, node->getPusherZone());
+	int zone1TabLength = 0;
+	while(zone1Tab[zone1TabLength] != NULL)
+		zone1TabLength++;
 
-	zoneListTab = createInitialZoneListTab(neiTab, boxesZone, pusherZone,
-			zoneListTab);
+	// Corrals without any goal (boxes on goals included)
+	bool* goalFreeTab = (bool*)malloc((zone1TabLength+1)*sizeof(bool));
+	for(int i=0;i<zone1TabLength;i++)
+		goalFreeTab[i] = zone1Tab[i]->andIsEmpty(goalZone);
 
-	int maxZoneToTest = DEADLOCKEDZONE_MAXZONESTOCREATE;
-	for(int i=1;i<maxN && maxZoneToTest>0;i++)
-		zoneListTab = createIZoneListTab(zoneListTab, zone1Tab, i+1,
-											&maxZoneToTest);
+	// Get all empty neighbours positions of last moved box (8 positions)
+	int* neiTab = createNeighboursTab(boxesZone, levelPosBox);
 
-	// Test each created zone
+	bool* usedTab = (bool*)malloc((zone1TabLength+1)*sizeof(bool));
 	bool blocked = false;
-	for(int i=0;i<maxN && blocked == false;i++)
+	for(int i=0;i<zone1TabLength && !blocked;i++)
 	{
-		ZoneList* currentZoneList = zoneListTab[i];
-		while(currentZoneList != NULL)
+		// Corrals around last moved box
+		bool nearBox = false;
+		for(int j=0;j<8 && !nearBox;j++)
+			nearBox = (neiTab[j] != -1 && zone1Tab[i]->readPos(neiTab[j]) == 1);
+
+		if(!nearBox)
+			continue;
+
+		blocked = isDeadlockedCorral(zone1Tab[i], node);
+
+		// A corral without goal is joined with every corral without goal
+		// sharing a box with it, one layer after the other
+		if(!blocked && goalFreeTab[i])
 		{
-			if(isBlockedZone(currentZoneList->zone, treenode, BLOCKEDZONE_DEEPNESS))
+			for(int j=0;j<zone1TabLength;j++)
+				usedTab[j] = (j == i);
+
+			Zone* testZone = new Zone(zone1Tab[i]);
+			bool grown = true;
+			while(grown && !blocked)
 			{
-				blocked = true;
-				break;
+				blocked = isCachedBlockedZone(testZone, treenode);
+
+				grown = false;
+				Zone* layerZone = new Zone(testZone->getLength());
+				for(int j=0;j<zone1TabLength && !blocked;j++)
+				{
+					if(   !usedTab[j] && goalFreeTab[j]
+					   && testZone->intersects(zone1Tab[j]))
+					{
+						layerZone->applyOrWith(zone1Tab[j]);
+						usedTab[j] = true;
+						grown = true;
+					}
+				}
+				testZone->applyOrWith(layerZone);
+				delete layerZone;
 			}
-			else
-				currentZoneList = currentZoneList->next;
+			delete testZone;
 		}
 	}
 
 	// Free memory
-	int i=0;
-	while(zone1Tab[i] != NULL)
-	{
+	for(int i=0;i<zone1TabLength;i++)
 		delete zone1Tab[i];
-		i++;
-	}
 	free(zone1Tab);
+	free(goalFreeTab);
+	free(usedTab);
+	free(neiTab);
 
-	for(int i=0;i<maxN;i++)
+	return blocked;
+}
+
+Zone* Deadlock::createPICorralZone(const Node* node) const
+{
+	Zone* boxesZone = node->getBoxesZone();
+
+	Zone** zone1Tab = createZone1Tab(boxesZone, node->getPusherZone());
+
+	// Keep PI-corral with less boxes
+	Zone* piCorralZone = NULL;
+	int piCorralBoxes = 0;
+	for(int i=0;zone1Tab[i] != NULL;i++)
 	{
-		delete zoneListTab[i];
+		if(isPICorral(zone1Tab[i], node))
+		{
+			int corralBoxesNumber = zone1Tab[i]->andPopcount(boxesZone);
+			if(piCorralZone == NULL || corralBoxesNumber < piCorralBoxes)
+			{
+				if(piCorralZone)
+					delete piCorralZone;
+				piCorralZone = new Zone(zone1Tab[i], boxesZone, Zone::USE_AND);
+				piCorralBoxes = corralBoxesNumber;
+			}
+		}
 	}
-	free(zoneListTab);
-	free(neiTab);
 
-	return blocked;
+	for(int i=0;zone1Tab[i] != NULL;i++)
+		delete zone1Tab[i];
+	free(zone1Tab);
+
+	return piCorralZone;
 }
 
 bool Deadlock::simpleDeadlock(TreeNode* treenode) const
 {
+	// Full validation : tests of last pushed box are made on every box
+	if(treenode->getPushedBoxPostPosition() == -1 || DEADLOCK_FULLTEST)
+	{
+		if(deadlockedCorner(treenode))
+			return true;
+
+		Zone* boxesZone = treenode->getNode()->getBoxesZone();
+		for(int i=0;i<zoneToLevelPosLength;i++)
+		{
+			if(   boxesZone->readPos(i)
+			   && (   deadlockedLastMove(treenode, zoneToLevelPos[i])
+			       || deadlockedFrozen(treenode, zoneToLevelPos[i])))
+				return true;
+		}
+
+		return deadlockedList(treenode);
+	}
+
 	if(deadlockedCorner(treenode))
 		return true;
 	else if(deadlockedLastMove(treenode))
 		return true;
+	else if(deadlockedFrozen(treenode))
+		return true;
+	else if(deadlockedList(treenode))
+		return true;
 	else
 		return false;
 }
 
+bool Deadlock::measuredCheck(int check, TreeNode* treenode) const
+{
+	long long start = Util::getNanoTime();
+
+	bool deadlocked;
+	switch(check)
+	{
+		case CHECK_CORNER : deadlocked = deadlockedCorner(treenode); break;
+		case CHECK_LASTMOVE : deadlocked = deadlockedLastMove(treenode); break;
+		case CHECK_FROZEN : deadlocked = deadlockedFrozen(treenode); break;
+		case CHECK_LIST : deadlocked = deadlockedList(treenode); break;
+		case CHECK_MATCHING : deadlocked = deadlockedMatching(treenode); break;
+		default : deadlocked = complexDeadlock(treenode); break;
+	}
+
+	checkTimes[check] += Util::getNanoTime() - start;
+	checkCalls[check]++;
+	if(deadlocked)
+		checkHits[check]++;
+
+	return deadlocked;
+}
+
+void Deadlock::sortChecks(void) const
+{
+	// Checks without any deadlock found are not useful on this level
+	for(int i=0;i<CHECK_NUMBER;i++)
+	{
+		if(checkCalls[i] >= CHECK_DISABLE_CALLS && checkHits[i] == 0)
+			checkEnabled[i] = false;
+	}
+
+	// Insertion sort by hits per nanosecond (hits[a]/times[a] >
+	// hits[b]/times[b] without division)
+	for(int i=1;i<CHECK_NUMBER;i++)
+	{
+		int check = checkOrder[i];
+		int j = i-1;
+		while(j >= 0
+		   && (double)checkHits[check]*(double)(checkTimes[checkOrder[j]]+1)
+		    > (double)checkHits[checkOrder[j]]*(double)(checkTimes[check]+1))
+		{
+			checkOrder[j+1] = checkOrder[j];
+			j--;
+		}
+		checkOrder[j+1] = check;
+	}
+}
+
 bool Deadlock::complexDeadlock(TreeNode* treenode) const
 {
-	if(deadlockedZone(treenode, DEADLOCKEDZONE_MAXLEVELOFJUNCTIONS))
+	if(deadlockedZone(treenode))
 		return true;
 	else
 		return false;
 }
 
+bool Deadlock::isFrozenBox(int posBox, const Zone* boxesZone, Zone* wallZone,
+		bool* offGoal, int n) const
+{
+	// Too far from the pushed box, we consider it's not frozen
+	if(n == 0)
+		return false;
+
+	int zonePosBox = levelToZonePos[posBox];
+	bool boxOffGoal = (goalZone->readPos(zonePosBox) == 0);
+
+	// This box is considered as a wall while we test its neighbours
+	wallZone->write1ToPos(zonePosBox);
+
+	bool frozen =
+		   isFrozenAxis(posBox, 1, boxesZone, wallZone, &boxOffGoal, n)
+		&& isFrozenAxis(posBox, level->getColsNumber(), boxesZone, wallZone,
+				&boxOffGoal, n);
+
+	wallZone->write0ToPos(zonePosBox);
+
+	if(frozen && boxOffGoal)
+		*offGoal = true;
+
+	return frozen;
+}
+
+bool Deadlock::isFrozenAxis(int posBox, int step, const Zone* boxesZone,
+		Zone* wallZone, bool* offGoal, int n) const
+{
+	int posPrev = levelToZonePos[posBox - step];
+	int posNext = levelToZonePos[posBox + step];
+
+	// Wall on one side
+	if(posPrev == -1 || posNext == -1)
+		return true;
+
+	// Box being tested on one side
+	if(wallZone->readPos(posPrev) == 1 || wallZone->readPos(posNext) == 1)
+		return true;
+
+	// Deadlock cells on both sides
+	if(deadlockZone->readPos(posPrev) == 1 && deadlockZone->readPos(posNext) == 1)
+		return true;
+
+	// Frozen box on one side
+	bool neighbourOffGoal = false;
+	if(   (   boxesZone->readPos(posPrev) == 1
+		   && isFrozenBox(posBox - step, boxesZone, wallZone,
+				   &neighbourOffGoal, n-1))
+	   || (   boxesZone->readPos(posNext) == 1
+		   && isFrozenBox(posBox + step, boxesZone, wallZone,
+				   &neighbourOffGoal, n-1)))
+	{
+		if(neighbourOffGoal)
+			*offGoal = true;
+		return true;
+	}
+
+	return false;
+}
+
+int Deadlock::createPatternMask(const Zone* boxesZone, int posBox) const
+{
+	int n = level->getColsNumber();
+
+	// neighbours positions (up-left, up, up-right, left, right, down-left,
+	// down, down-right)
+	int neiTab[8];
+	neiTab[0] = levelToZonePos[posBox - n - 1];
+	neiTab[1] = levelToZonePos[posBox - n];
+	neiTab[2] = levelToZonePos[posBox - n + 1];
+	neiTab[3] = levelToZonePos[posBox - 1];
+	neiTab[4] = levelToZonePos[posBox + 1];
+	neiTab[5] = levelToZonePos[posBox + n - 1];
+	neiTab[6] = levelToZonePos[posBox + n];
+	neiTab[7] = levelToZonePos[posBox + n + 1];
+
+	int mask = 0;
+	for(int i=0;i<8;i++)
+	{
+		if(neiTab[i] != -1 && boxesZone->readPos(neiTab[i]) == 1)
+			mask |= (1 << i);
+	}
+
+	return mask;
+}
+
+bool Deadlock::isDeadlockedPattern(int posBox, int mask) const
+{
+	// Box on a dead square
+	int boxPos = zoneToBoxPos[levelToZonePos[posBox]];
+	if(boxPos == -1)
+		return true;
+
+	int entry = boxPos*PATTERN_NUMBER + mask;
+
+	if(patternTab[entry] == PATTERN_UNKNOWN)
+	{
+		if(searchPattern(posBox, mask))
+			patternTab[entry] = PATTERN_DEADLOCK;
+		else
+			patternTab[entry] = PATTERN_FREE;
+	}
+
+	return (patternTab[entry] == PATTERN_DEADLOCK);
+}
+
+bool Deadlock::searchPattern(int posBox, int mask) const
+{
+	const int w = PATTERN_WINDOW;
+	const int wLength = w*w;
+	int n = level->getColsNumber();
+	int m = level->getRowsNumber();
+	int boxRow = posBox/n;
+	int boxCol = posBox%n;
+
+	// Window of walls (-1), goals (bit 1) and deadlock cells (bit 2)
+	int window[PATTERN_WINDOW*PATTERN_WINDOW];
+	for(int i=0;i<wLength;i++)
+	{
+		int row = boxRow + i/w - w/2;
+		int col = boxCol + i%w - w/2;
+		window[i] = -1;
+		if(row >= 0 && row < m && col >= 0 && col < n)
+		{
+			int zonePos = levelToZonePos[row*n + col];
+			if(zonePos != -1)
+				window[i] = goalZone->readPos(zonePos)
+				          | (deadlockZone->readPos(zonePos) << 1);
+		}
+	}
+
+	// Window cell of each cell of the 3x3 boxes square
+	int squareTab[9];
+	for(int i=0;i<9;i++)
+		squareTab[i] = (i/3 + 1)*w + i%3 + 1;
+
+	// 3x3 boxes (center is the tested box)
+	int startBoxes = (mask & 0xF) | (1 << 4) | ((mask & 0xF0) << 1);
+
+	// States are (boxes of the 3x3 square, first cell of pusher region)
+	int statesLength = (1 << 9)*wLength;
+	for(int i=0;i<statesLength;i++)
+		patternStates[i] = 0;
+	int* queue = (int*)malloc(statesLength*sizeof(int));
+	int queueStart = 0;
+	int queueEnd = 0;
+
+	// Pusher could be in every region
+	int windowBoxes = 0;
+	for(int i=0;i<9;i++)
+		if((startBoxes >> i) & 1)
+			windowBoxes |= (1 << squareTab[i]);
+	for(int i=0;i<wLength;i++)
+	{
+		if(window[i] != -1 && ((windowBoxes >> i) & 1) == 0)
+		{
+			int region = createPatternRegion(window, windowBoxes, i);
+			int first = 0;
+			while(((region >> first) & 1) == 0)
+				first++;
+			int state = startBoxes*wLength + first;
+			if(patternStates[state] == 0)
+			{
+				patternStates[state] = 1;
+				queue[queueEnd] = state;
+				queueEnd++;
+			}
+		}
+	}
+
+	bool deadlocked = true;
+	while(queueStart < queueEnd && deadlocked)
+	{
+		int boxes = queue[queueStart]/wLength;
+		int first = queue[queueStart]%wLength;
+		queueStart++;
+
+		windowBoxes = 0;
+		bool solved = true;
+		for(int i=0;i<9;i++)
+		{
+			if((boxes >> i) & 1)
+			{
+				windowBoxes |= (1 << squareTab[i]);
+				if((window[squareTab[i]] & 1) == 0)
+					solved = false;
+			}
+		}
+
+		// Every remaining box is on a goal
+		if(solved)
+		{
+			deadlocked = false;
+			break;
+		}
+
+		int region = createPatternRegion(window, windowBoxes, first);
+
+		// Try every push of every box
+		int dirTab[4] = {-1, 1, -w, w};
+		for(int i=0;i<9;i++)
+		{
+			if(((boxes >> i) & 1) == 0)
+				continue;
+			int cell = squareTab[i];
+			for(int d=0;d<4;d++)
+			{
+				int pusherCell = cell - dirTab[d];
+				int nextCell = cell + dirTab[d];
+
+				// pusher must reach its cell, next cell must be free and not
+				// a deadlock cell
+				if(((region >> pusherCell) & 1) == 0
+				 || window[nextCell] == -1
+				 || ((windowBoxes >> nextCell) & 1) == 1
+				 || (window[nextCell] & 2))
+					continue;
+
+				int newBoxes = boxes & ~(1 << i);
+				int newWindowBoxes = windowBoxes & ~(1 << cell);
+				int nextRow = nextCell/w;
+				int nextCol = nextCell%w;
+
+				// If box stays in the 3x3 square
+				if(nextRow >= 1 && nextRow <= 3 && nextCol >= 1 && nextCol <= 3)
+				{
+					newBoxes |= (1 << ((nextRow-1)*3 + nextCol-1));
+					newWindowBoxes |= (1 << nextCell);
+				}
+
+				int newRegion = createPatternRegion(window, newWindowBoxes,
+						cell);
+				int newFirst = 0;
+				while(((newRegion >> newFirst) & 1) == 0)
+					newFirst++;
+				int state = newBoxes*wLength + newFirst;
+				if(patternStates[state] == 0)
+				{
+					patternStates[state] = 1;
+					queue[queueEnd] = state;
+					queueEnd++;
+				}
+			}
+		}
+	}
+
+	free(queue);
+
+	return deadlocked;
+}
+
+int Deadlock::createPatternRegion(const int* window, int boxes, int cell) const
+{
+	const int w = PATTERN_WINDOW;
+	const int wLength = w*w;
+
+	int region = (1 << cell);
+	int stack[PATTERN_WINDOW*PATTERN_WINDOW];
+	int stackLength = 1;
+	stack[0] = cell;
+
+	bool borderAdded = false;
+	while(stackLength > 0)
+	{
+		stackLength--;
+		int current = stack[stackLength];
+		int row = current/w;
+		int col = current%w;
+
+		int neiTab[4];
+		int neiLength = 0;
+		if(col > 0)
+			neiTab[neiLength++] = current - 1;
+		if(col < w-1)
+			neiTab[neiLength++] = current + 1;
+		if(row > 0)
+			neiTab[neiLength++] = current - w;
+		if(row < w-1)
+			neiTab[neiLength++] = current + w;
+
+		for(int i=0;i<neiLength;i++)
+		{
+			int nei = neiTab[i];
+			if(window[nei] != -1 && ((boxes >> nei) & 1) == 0
+			  && ((region >> nei) & 1) == 0)
+			{
+				region |= (1 << nei);
+				stack[stackLength++] = nei;
+			}
+		}
+
+		// Cells around the 3x3 square are considered connected together
+		if(!borderAdded && (row == 0 || row == w-1 || col == 0 || col == w-1))
+		{
+			borderAdded = true;
+			for(int i=0;i<wLength;i++)
+			{
+				int r = i/w;
+				int c = i%w;
+				if((r == 0 || r == w-1 || c == 0 || c == w-1)
+				  && window[i] != -1 && ((region >> i) & 1) == 0)
+				{
+					region |= (1 << i);
+					stack[stackLength++] = i;
+				}
+			}
+		}
+	}
+
+	return region;
+}
+
 Zone** Deadlock::createZone1Tab(Zone* boxesZone, Zone* pusherZone) const
 {
 	int nCols = level->getColsNumber();
@@ -429,103 +1011,6 @@ int* Deadlock::createNeighboursTab(Zone* boxesZone, int posBox) const
 	return tab;
 }
 
-ZoneList** Deadlock::createInitialZoneListTab(int* neiTab, Zone* boxesZone,
-		Zone* pusherZone, ZoneList** zoneListTab) const
-{
-	int nCols = level->getColsNumber();
-
-	// For each neighbours
-	for(int i=0;i<8;i++)
-	{
-		// if neighbours is a free cell
-		if(neiTab[i] != -1)
-		{
-			// if position is not included in previous keeped zone
-			ZoneList* currentZoneList = zoneListTab[0];
-			bool found = false;
-			while(currentZoneList != NULL)
-			{
-				if(currentZoneList->zone->readPos(neiTab[i]))
-				{
-					found = true;
-					break;
-				}
-				else
-					currentZoneList = currentZoneList->next;
-			}
-
-			// If new zone
-			if(!found)
-			{
-				// Add new zone to the first chained list of zones
-				Zone* newZone = new Zone(boxesZone, zoneToLevelPos[neiTab[i]],
-						levelToZonePos, nCols);
-				if(!pusherZone->isEgal(newZone))
-					zoneListTab[0] = new ZoneList(newZone, zoneListTab[0]);
-				else
-					delete newZone;
-			}
-		}
-	}
-
-	return zoneListTab;
-}
-
-ZoneList** Deadlock::createIZoneListTab(ZoneList** zoneListTab,
-		Zone** zoneTab, int size, int* maxZoneToTest) const
-{
-	// for each zone of last iteration
-	ZoneList* currentZoneList = zoneListTab[size-2];
-	while(currentZoneList != NULL)
-	{
-		// For each zone of tab
-		int i=0;
-		while(zoneTab[i] != NULL && (*maxZoneToTest) > 0)
-		{
-			// If they are at least one box in common and are not the same
-			Zone* testZone = new Zone(currentZoneList->zone,
-					zoneTab[i], Zone::USE_AND);
-			if(!testZone->isFullOf0())
-			{
-				Zone* newZone = new Zone(currentZoneList->zone,
-					zoneTab[i], Zone::USE_OR);
-
-				// If junction is not the same than previous size zone
-				if(!newZone->isEgal(currentZoneList->zone))
-				{
-					// If this junction is new
-					ZoneList* currentZoneList2 = zoneListTab[size-1];
-					bool found = false;
-					while(currentZoneList2 != NULL)
-					{
-						if(newZone->isEgal(currentZoneList2->zone))
-						{
-							found = true;
-							(*maxZoneToTest)--;
-							break;
-						}
-						else
-							currentZoneList2 = currentZoneList2->next;
-					}
-
-					if(!found)
-						zoneListTab[size-1] = new ZoneList(newZone,
-								zoneListTab[size-1]);
-					else
-						delete newZone;
-				}
-				else
-					delete newZone;
-			}
-			delete testZone;
-			i++;
-		}
-		currentZoneList = currentZoneList->next;
-	}
-
-	return zoneListTab;
-}
-
 bool Deadlock::isBlockedZone(const Zone* zone, TreeNode* treenode, int n) const
 {
 	// Limit of recursivity so complexity doesn't explode with some levels
@@ -538,21 +1023,16 @@ bool Deadlock::isBlockedZone(const Zone* zone, TreeNode* treenode, int n) const
 
 	// Is any pusher or goal present in this zone ?
 	Zone* pusherZone = treenode->getNode()->getPusherZone();
-	Zone* reachablePusherZone = new Zone(zone, pusherZone, Zone::USE_AND);
-	reachablePusherZone->applyMinusWith(boxesZone);
-
-	Zone* reachableGoal = new Zone(zone, goalZone, Zone::USE_AND);
+	zone->andNotInto(boxesZone, predicateZone);
 
 	// If pusher and goal not in zone
-	if(reachablePusherZone->isFullOf0() && reachableGoal->isFullOf0())
+	if(!predicateZone->intersects(pusherZone) && !zone->intersects(goalZone))
 	{
-		Zone* reachableBoxes = new Zone(zone, boxesZone, Zone::USE_AND);
-
 		// For each pos of the zone
 		for(int j=0;j<zoneToLevelPosLength;j++)
 		{
 			// If this is a box of the zone
-			if(reachableBoxes->readPos(j) == 1)
+			if(zone->readPos(j) == 1 && boxesZone->readPos(j) == 1)
 			{
 				ret = isZoneBlockedBox(zoneToLevelPos[j],
 						treenode, zone, n);
@@ -561,15 +1041,10 @@ bool Deadlock::isBlockedZone(const Zone* zone, TreeNode* treenode, int n) const
 					break;
 			}
 		}
-
-		delete reachableBoxes;
 	}
 	else
 		ret = false;
 
-	delete reachablePusherZone;
-	delete reachableGoal;
-
 	return ret;
 }
 
@@ -817,3 +1292,534 @@ bool Deadlock::isZoneBlockedBox(int boxPos, TreeNode* treenode,
 	else
 		return false; // possible move with no deadlock
 }
+
+bool Deadlock::isDeadlockedCorral(const Zone* corralZone,
+		const Node* node) const
+{
+	Zone* boxesZone = node->getBoxesZone();
+	Zone* pusherZone = node->getPusherZone();
+	int nCols = level->getColsNumber();
+
+	// Only boxes of the corral are kept
+	Zone* corralBoxes = new Zone(corralZone, boxesZone, Zone::USE_AND);
+
+	// If every box of the corral is on a goal, it's not a deadlock
+	if(corralBoxes->isIncludedIn(goalZone))
+	{
+		delete corralBoxes;
+		return false;
+	}
+
+	// Empty positions of the corral
+	Zone* corralInside = new Zone(corralZone);
+	corralInside->applyMinusWith(boxesZone);
+
+	// Starting node (pusher position is a free cell of its zone)
+	int pusherPos = 0;
+	while(pusherZone->readPos(pusherPos) == 0
+	   || boxesZone->readPos(pusherPos) == 1)
+		pusherPos++;
+	Node* startNode = new Node(solver);
+	startNode->setBoxesZone(corralBoxes);
+	startNode->setPusherZone(new Zone(corralBoxes, zoneToLevelPos[pusherPos],
+			levelToZonePos, nCols));
+
+	// Same corral with same boxes and pusher region was already searched
+	int keyLength = 0;
+	unsigned int* key = createVerdictKey(VERDICTKEY_CORRAL, true, corralZone,
+			corralBoxes, startNode->getPusherZone(), &keyLength);
+	int verdict = solver->getVerdictCache()->getVerdict(key, keyLength);
+	if(verdict != VerdictCache::VERDICT_UNKNOWN)
+	{
+		free(key);
+		delete startNode;
+		delete corralInside;
+		return (verdict == VerdictCache::VERDICT_DEADLOCK);
+	}
+
+	bool deadlocked = searchBoxes(startNode, corralInside, CORRAL_MAXNODES);
+
+	delete startNode;
+	delete corralInside;
+
+	if(deadlocked)
+		solver->getVerdictCache()->addVerdict(key, keyLength,
+				VerdictCache::VERDICT_DEADLOCK);
+	else
+		solver->getVerdictCache()->addVerdict(key, keyLength,
+				VerdictCache::VERDICT_FREE);
+	free(key);
+
+	return deadlocked;
+}
+
+bool Deadlock::searchBoxes(const Node* startNode, const Zone* exitZone,
+		int maxNodes) const
+{
+	TreeNode* startTreeNode = new TreeNode(new Node(startNode));
+
+	HashTable* searchTable = new HashTable(CORRAL_HASHTABLE_SIZE);
+	searchTable->addItem(startTreeNode);
+	TreeNode** queue = (TreeNode**)malloc(maxNodes*sizeof(TreeNode*));
+	int queueStart = 0;
+	int queueEnd = 1;
+	queue[0] = startTreeNode;
+
+	// Breadth-first search of every pushes of boxes
+	bool deadlocked = true;
+	while(queueStart < queueEnd && deadlocked)
+	{
+		TreeNode* current = queue[queueStart];
+		queueStart++;
+
+		Node** children = current->getNode()->findChildren();
+		for(int i=0;children[i] != NULL;i++)
+		{
+			Node* child = children[i];
+			if(!deadlocked || searchTable->isPresent(child))
+			{
+				delete child;
+				continue;
+			}
+
+			TreeNode* childTreeNode = new TreeNode(child);
+			current->addChild(childTreeNode);
+
+			if(simpleDeadlock(childTreeNode))
+			{
+				delete childTreeNode;
+				continue;
+			}
+
+			// Every box on goals or pusher in exit zone : not deadlocked
+			bool exit = false;
+			if(exitZone)
+			{
+				exitZone->andNotInto(child->getBoxesZone(), predicateZone);
+				exit = predicateZone->intersects(child->getPusherZone());
+			}
+			if(child->getBoxesZone()->isIncludedIn(goalZone) || exit)
+				deadlocked = false;
+			// Too many nodes, we stop the search (not deadlocked)
+			else if(queueEnd == maxNodes)
+				deadlocked = false;
+			else
+			{
+				searchTable->addItem(childTreeNode);
+				queue[queueEnd] = childTreeNode;
+				queueEnd++;
+			}
+		}
+		free(children);
+	}
+
+	delete searchTable;
+	free(queue);
+	delete startTreeNode;
+
+	return deadlocked;
+}
+
+void Deadlock::initDeadlockList(int numberOfBoxes)
+{
+	deadlockIndexTab = (int**)malloc(boxToZonePosLength*sizeof(int*));
+	deadlockIndexLengths = (int*)malloc(boxToZonePosLength*sizeof(int));
+	for(int i=0;i<boxToZonePosLength;i++)
+	{
+		deadlockIndexTab[i] = NULL;
+		deadlockIndexLengths[i] = 0;
+	}
+	deadlockNodeList = (Node**)malloc(1*sizeof(Node*));
+	deadlockNodeList[0] = NULL;
+
+	if(numberOfBoxes > DEADLOCKLIST_MAXBOXES)
+		numberOfBoxes = DEADLOCKLIST_MAXBOXES;
+	if(numberOfBoxes > level->getBoxesNumber())
+		numberOfBoxes = level->getBoxesNumber();
+
+	const char* packName = level->getPackName();
+	int levelId = level->getId();
+
+	char** file = (char**)malloc(6*sizeof(char*));
+	for(int i=0;i<5;i++)
+	{
+		file[i] = (char*)malloc(300*sizeof(char));
+		file[i][0] = '\0';
+	}
+	strcpy(file[0], "data");
+	strcpy(file[1], "solver");
+	sprintf(file[2], "%s", packName);
+	sprintf(file[3], "%d", levelId);
+	strcpy(file[4], "deadlockNodeList.dat");
+	file[5] = NULL;
+
+	deadlockListFileName = Util::generateRep(file);
+
+	// Load existing list and complete until numberOfBoxes reached
+	if(Util::isThisFileExists(deadlockListFileName))
+		loadDeadlockList(deadlockListFileName);
+
+	if(deadlockListBoxes < numberOfBoxes)
+	{
+		int* tab = (int*)malloc(numberOfBoxes*sizeof(int));
+		for(int k=deadlockListBoxes+1;k<=numberOfBoxes;k++)
+		{
+			for(int i=0;i<boxToZonePosLength;i++)
+			{
+				tab[0] = i;
+				createDeadlockList(tab, 1, k);
+			}
+			deadlockListBoxes = k;
+		}
+		free(tab);
+
+		// Directory of level
+		free(file[4]);
+		file[4] = NULL;
+		Util::createRep(file);
+		saveDeadlockList();
+	}
+
+	for(int i=0;i<5;i++)
+		free(file[i]);
+	free(file);
+}
+
+void Deadlock::createDeadlockList(int* tab, int tabLength,
+		int numberOfBoxes)
+{
+	int nCols = level->getColsNumber();
+
+	if(tabLength == numberOfBoxes)
+	{
+		// Boxes must be connected (8 neighbours)
+		bool* connected = (bool*)malloc(numberOfBoxes*sizeof(bool));
+		connected[0] = true;
+		for(int i=1;i<numberOfBoxes;i++)
+			connected[i] = false;
+		bool added = true;
+		while(added)
+		{
+			added = false;
+			for(int i=0;i<numberOfBoxes;i++)
+			{
+				if(connected[i])
+					continue;
+				int pos1 = zoneToLevelPos[boxToZonePos[tab[i]]];
+				for(int j=0;j<numberOfBoxes && !connected[i];j++)
+				{
+					int pos2 = zoneToLevelPos[boxToZonePos[tab[j]]];
+					if(   connected[j]
+					   && abs(pos1/nCols - pos2/nCols) <= 1
+					   && abs(pos1%nCols - pos2%nCols) <= 1)
+					{
+						connected[i] = true;
+						added = true;
+					}
+				}
+			}
+		}
+		bool allConnected = true;
+		for(int i=0;i<numberOfBoxes;i++)
+			allConnected = allConnected && connected[i];
+		free(connected);
+
+		if(allConnected)
+		{
+			int* zoneTab = (int*)malloc(numberOfBoxes*sizeof(int));
+			for(int i=0;i<numberOfBoxes;i++)
+				zoneTab[i] = boxToZonePos[tab[i]];
+			deadlockListTest(zoneTab, numberOfBoxes);
+			free(zoneTab);
+		}
+		return;
+	}
+
+	// Boxes of a connected position are all close to the first one
+	int firstPos = zoneToLevelPos[boxToZonePos[tab[0]]];
+	for(int i=tab[tabLength-1]+1;i<boxToZonePosLength;i++)
+	{
+		int pos = zoneToLevelPos[boxToZonePos[i]];
+		if(   abs(pos/nCols - firstPos/nCols) < numberOfBoxes
+		   && abs(pos%nCols - firstPos%nCols) < numberOfBoxes)
+		{
+			tab[tabLength] = i;
+			createDeadlockList(tab, tabLength+1, numberOfBoxes);
+		}
+	}
+}
+
+void Deadlock::addToDeadlockList(Node* node)
+{
+	deadlockNodeListLength++;
+	deadlockNodeList = (Node**)realloc(deadlockNodeList,
+			(deadlockNodeListLength+1)*sizeof(Node*));
+	deadlockNodeList[deadlockNodeListLength-1] = node;
+	deadlockNodeList[deadlockNodeListLength] = NULL;
+
+	// Index of the node for each of its boxes
+	Zone* boxesZone = node->getBoxesZone();
+	for(int i=0;i<boxToZonePosLength;i++)
+	{
+		if(boxesZone->readPos(boxToZonePos[i]))
+		{
+			deadlockIndexLengths[i]++;
+			deadlockIndexTab[i] = (int*)realloc(deadlockIndexTab[i],
+					deadlockIndexLengths[i]*sizeof(int));
+			deadlockIndexTab[i][deadlockIndexLengths[i]-1] =
+					deadlockNodeListLength-1;
+		}
+	}
+}
+
+void Deadlock::loadDeadlockList(const char* fileName)
+{
+	FILE* file = fopen(fileName, "rb");
+	if(!file)
+		return;
+
+	// List is only valid with same format, limits of search and zone
+	int version, maxNodes, maxBoxes, zoneLength, boxesNumber, nodesNumber;
+	bool valid = (fread(&version, sizeof(int), 1, file) == 1)
+	          && (fread(&maxNodes, sizeof(int), 1, file) == 1)
+	          && (fread(&maxBoxes, sizeof(int), 1, file) == 1)
+	          && (fread(&zoneLength, sizeof(int), 1, file) == 1)
+	          && (fread(&boxesNumber, sizeof(int), 1, file) == 1)
+	          && (version == DEADLOCKLIST_FILEVERSION)
+	          && (maxNodes == DEADLOCKLIST_MAXNODES)
+	          && (maxBoxes == DEADLOCKLIST_MAXBOXES)
+	          && (zoneLength == zoneToLevelPosLength);
+
+	// List is only valid with same goals and dead squares
+	if(valid)
+	{
+		Zone* fileGoalZone = new Zone(zoneLength);
+		Zone* fileDeadZone = new Zone(zoneLength);
+		valid = fileGoalZone->loadFromBinaryFile(file)
+		     && fileGoalZone->isEgal(goalZone)
+		     && fileDeadZone->loadFromBinaryFile(file)
+		     && fileDeadZone->isEgal(deadlockZone)
+		     && (fread(&nodesNumber, sizeof(int), 1, file) == 1);
+		delete fileGoalZone;
+		delete fileDeadZone;
+	}
+
+	for(int i=0;valid && i<nodesNumber;i++)
+	{
+		Zone* boxesZone = new Zone(zoneLength);
+		Zone* pusherZone = new Zone(zoneLength);
+		if(   boxesZone->loadFromBinaryFile(file)
+		   && pusherZone->loadFromBinaryFile(file))
+			addToDeadlockList(new Node(solver, pusherZone, boxesZone));
+		else
+		{
+			delete boxesZone;
+			delete pusherZone;
+			valid = false;
+		}
+	}
+
+	if(valid)
+		deadlockListBoxes = boxesNumber;
+
+	fclose(file);
+}
+
+void Deadlock::saveDeadlockList() const
+{
+	if(!deadlockListFileName)
+		return;
+
+	FILE* file = fopen(deadlockListFileName, "wb");
+	if(!file)
+		return;
+
+	int version = DEADLOCKLIST_FILEVERSION;
+	int maxNodes = DEADLOCKLIST_MAXNODES;
+	int maxBoxes = DEADLOCKLIST_MAXBOXES;
+	fwrite(&version, sizeof(int), 1, file);
+	fwrite(&maxNodes, sizeof(int), 1, file);
+	fwrite(&maxBoxes, sizeof(int), 1, file);
+	fwrite(&zoneToLevelPosLength, sizeof(int), 1, file);
+	fwrite(&deadlockListBoxes, sizeof(int), 1, file);
+	goalZone->saveInBinaryFile(file);
+	deadlockZone->saveInBinaryFile(file);
+	fwrite(&deadlockNodeListLength, sizeof(int), 1, file);
+	for(int i=0;i<deadlockNodeListLength;i++)
+	{
+		deadlockNodeList[i]->getBoxesZone()->saveInBinaryFile(file);
+		deadlockNodeList[i]->getPusherZone()->saveInBinaryFile(file);
+	}
+
+	fclose(file);
+}
+
+bool Deadlock::augmentMatching(int pos, bool* visitedGoal) const
+{
+	int goalsNumber = level->getGoalsNumber();
+
+	if(!goalReachDone[pos])
+		initGoalReachRow(pos);
+
+	for(int i=0;i<goalsNumber;i++)
+	{
+		if(!goalReachTab[pos*goalsNumber+i] || visitedGoal[i])
+			continue;
+
+		visitedGoal[i] = true;
+
+		// Free goal or its box can take another goal
+		int otherPos = matchGoalTab[i];
+		if(otherPos == -1 || augmentMatching(otherPos, visitedGoal))
+		{
+			matchGoalTab[i] = pos;
+			matchBoxTab[pos] = i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Deadlock::initGoalReachRow(int pos) const
+{
+	int goalsNumber = level->getGoalsNumber();
+	const int* goalsPositions = solver->getGoalsPositions();
+	const int* const* costTable = solver->getCostTable();
+	int zonePos = boxToZonePos[pos];
+
+	if(costTable)
+	{
+		for(int i=0;i<goalsNumber;i++)
+			goalReachTab[pos*goalsNumber+i]
+			    = (costTable[pos][goalsPositions[i]] != INT_MAX);
+	}
+	else
+	{
+		// Box alone with a pusher which can be everywhere
+		Zone* boxesZone = new Zone(zoneToLevelPosLength);
+		boxesZone->write1ToPos(zonePos);
+		Zone* pusherZone = new Zone(zoneToLevelPosLength);
+		pusherZone->applyNot();
+		Node* node = new Node(solver, pusherZone, boxesZone);
+
+		DijkstraBox* dBox = solver->getDijkstraBox();
+		dBox->setBox(node, zoneToLevelPos[zonePos]);
+		int* sol = dBox->resolvePositions();
+		for(int i=0;i<goalsNumber;i++)
+			goalReachTab[pos*goalsNumber+i]
+			    = (sol[goalsPositions[i]] != INT_MAX);
+
+		free(sol);
+		delete node;
+	}
+
+	goalReachDone[pos] = true;
+}
+
+bool Deadlock::isCachedBlockedZone(const Zone* zone, TreeNode* treenode) const
+{
+	Zone* boxesZone = treenode->getNode()->getBoxesZone();
+
+	// Pusher outside the zone
+	zone->andNotInto(boxesZone, predicateZone);
+	bool pusherOutside = !predicateZone->intersects(
+			treenode->getNode()->getPusherZone());
+
+	// Frozen boxes chains and deadlock lists of the test read every box, its
+	// nodes are built from the pusher's reachable region
+	int keyLength = 0;
+	unsigned int* key = createVerdictKey(VERDICTKEY_BLOCKEDZONE, pusherOutside,
+			zone, boxesZone, treenode->getNode()->getPusherZone(), &keyLength);
+	int verdict = solver->getVerdictCache()->getVerdict(key, keyLength);
+
+	bool blocked;
+	if(verdict != VerdictCache::VERDICT_UNKNOWN)
+		blocked = (verdict == VerdictCache::VERDICT_DEADLOCK);
+	else
+	{
+		blocked = isBlockedZone(zone, treenode, BLOCKEDZONE_DEEPNESS);
+		if(blocked)
+			solver->getVerdictCache()->addVerdict(key, keyLength,
+					VerdictCache::VERDICT_DEADLOCK);
+		else
+			solver->getVerdictCache()->addVerdict(key, keyLength,
+					VerdictCache::VERDICT_FREE);
+	}
+	free(key);
+
+	return blocked;
+}
+
+unsigned int* Deadlock::createVerdictKey(int kind, bool pusherOutside,
+		const Zone* zone1, const Zone* zone2, const Zone* zone3,
+		int* keyLength) const
+{
+	int cellNumber = zone1->getNumberCell();
+	int zoneNumber = (zone3 ? 3 : 2);
+
+	*keyLength = 2 + zoneNumber*cellNumber;
+	unsigned int* key = (unsigned int*)malloc(
+			(*keyLength)*sizeof(unsigned int));
+	key[0] = kind;
+	key[1] = pusherOutside;
+	for(int i=0;i<cellNumber;i++)
+	{
+		key[2+i] = zone1->getZoneTab()[i];
+		key[2+cellNumber+i] = zone2->getZoneTab()[i];
+		if(zone3)
+			key[2+2*cellNumber+i] = zone3->getZoneTab()[i];
+	}
+
+	return key;
+}
+
+bool Deadlock::isPICorral(const Zone* corralZone, const Node* node) const
+{
+	Zone* boxesZone = node->getBoxesZone();
+	Zone* pusherZone = node->getPusherZone();
+	int nCols = level->getColsNumber();
+
+	// A corral with every box on goals and no empty goal inside is solved
+	Zone* corralBoxes = new Zone(corralZone, boxesZone, Zone::USE_AND);
+	Zone* corralInside = new Zone(corralZone);
+	corralInside->applyMinusWith(boxesZone);
+	bool piCorral = !corralBoxes->isIncludedIn(goalZone)
+	             || corralInside->intersects(goalZone);
+
+	int dirTab[4] = {-1, 1, -nCols, nCols};
+	bool pushInside = false;
+	for(int i=0;i<zoneToLevelPosLength && piCorral;i++)
+	{
+		if(corralBoxes->readPos(i) == 0)
+			continue;
+
+		int pos = zoneToLevelPos[i];
+		for(int d=0;d<4 && piCorral;d++)
+		{
+			int prevPos = levelToZonePos[pos - dirTab[d]];
+			int nextPos = levelToZonePos[pos + dirTab[d]];
+
+			// Push impossible until a box of the corral moves
+			if(  prevPos == -1 || nextPos == -1
+			  || corralInside->readPos(prevPos) == 1
+			  || corralBoxes->readPos(prevPos) == 1
+			  || corralBoxes->readPos(nextPos) == 1)
+				continue;
+
+			// Push into the corral must be possible now, every other push
+			// could become possible and the corral is not a PI-corral
+			if(   corralInside->readPos(nextPos) == 1
+			   && pusherZone->readPos(prevPos) == 1
+			   && boxesZone->readPos(prevPos) == 0)
+				pushInside = true;
+			else
+				piCorral = false;
+		}
+	}
+
+	delete corralBoxes;
+	delete corralInside;
+
+	return (piCorral && pushInside);
+}
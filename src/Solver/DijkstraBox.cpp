@@ -11,40 +11,51 @@
 /* ------------*/
 /* Constructor */
 /* ------------*/
-DijkstraBox::DijkstraBox(const Solver* solver, Node* node, int boxPos):
+DijkstraBox::DijkstraBox(const Solver* solver):
+	dTable(NULL),
+	searchTable(NULL),
+	searchNumber(0),
 	solver(solver),
-	node(node),
-	boxPos(boxPos),
+	node(NULL),
+	boxesZone(NULL),
+	lToZPos(NULL),
+	boxPos(-1),
 	nCols(solver->getLevel()->getColsNumber()),
-	firstCell(NULL),
-	lastCell(NULL)
+	nPos(solver->getLevel()->getColsNumber()
+			*solver->getLevel()->getRowsNumber()),
+	queue(NULL),
+	queueStart(0),
+	queueEnd(0),
+	groupTab(NULL),
+	groupSearchTable(NULL),
+	floodQueue(NULL),
+	floodTable(NULL),
+	floodNumber(0),
+	testedZone(NULL),
+	goalsTested(NULL),
+	goalsBoxes(NULL),
+	goalsStart(NULL),
+	goalsValues(NULL),
+	goalsLastPositions(NULL),
+	goalsNext(NULL),
+	goalsHitNumber(0),
+	goalsMissNumber(0)
 {
-	const Level* level = solver->getLevel();
-	int nRows = level->getRowsNumber();
-	const int* lToZPos = solver->getLevelToZonePos();
-
-	int n = nCols*nRows*4;
-	dTable = (int*)malloc(n*sizeof(int));
-
-	Zone* boxes = node->getBoxesZone();
-
-	for(int i=0;i<n;i+=4)
+	dTable = (int*)malloc(4*nPos*sizeof(int));
+	searchTable = (int*)malloc(4*nPos*sizeof(int));
+	queue = (int*)malloc(4*nPos*sizeof(int));
+	groupTab = (int*)malloc(4*nPos*sizeof(int));
+	groupSearchTable = (int*)malloc(nPos*sizeof(int));
+	floodQueue = (int*)malloc(nPos*sizeof(int));
+	floodTable = (int*)malloc(nPos*sizeof(int));
+
+	for(int i=0;i<4*nPos;i++)
+		searchTable[i] = 0;
+	for(int i=0;i<nPos;i++)
 	{
-		if(lToZPos[i/4] != -1 && boxes->readPos(lToZPos[i/4]) != 1)
-			dTable[i] = dTable[i+1] = dTable[i+2] = dTable[i+3] = INT_MAX;
-		else
-			dTable[i] = dTable[i+1] = dTable[i+2] = dTable[i+3] = -1;
+		groupSearchTable[i] = 0;
+		floodTable[i] = 0;
 	}
-
-	// boxPos can move
-	dTable[boxPos*4] = dTable[boxPos*4+1] = dTable[boxPos*4+2] = dTable[boxPos*4+3] = INT_MAX;
-
-	// Init waiting cell chainedlist
-	firstCell = new CellList(boxPos, LEFT, 0, NULL);
-	lastCell = firstCell;
-	firstCell = new CellList(boxPos, RIGHT, 0, firstCell);
-	firstCell = new CellList(boxPos, UP, 0, firstCell);
-	firstCell = new CellList(boxPos, DOWN, 0, firstCell);
 }
 
 /* -----------*/
@@ -53,6 +64,53 @@ DijkstraBox::DijkstraBox(const Solver* solver, Node* node, int boxPos):
 DijkstraBox::~DijkstraBox()
 {
 	free(dTable);
+	free(searchTable);
+	free(queue);
+	free(groupTab);
+	free(groupSearchTable);
+	free(floodQueue);
+	free(floodTable);
+
+	if(goalsTested)
+	{
+		int keptNumber = solver->getZoneToLevelPosLength()*KEPT_GOALS_NUMBER;
+		for(int i=0;i<keptNumber;i++)
+		{
+			if(goalsTested[i])
+			{
+				delete goalsTested[i];
+				delete goalsBoxes[i];
+			}
+		}
+		free(goalsTested);
+		free(goalsBoxes);
+		free(goalsStart);
+		free(goalsValues);
+		free(goalsLastPositions);
+		free(goalsNext);
+	}
+}
+
+/* --------*/
+/* Setters */
+/* --------*/
+void DijkstraBox::setBox(Node* node, int boxPos)
+{
+	this->node = node;
+	this->boxesZone = node->getBoxesZone();
+	this->lToZPos = solver->getLevelToZonePos();
+	this->boxPos = boxPos;
+
+	// New search number : values of previous searches are not valid anymore
+	if(searchNumber == INT_MAX)
+	{
+		for(int i=0;i<4*nPos;i++)
+			searchTable[i] = 0;
+		for(int i=0;i<nPos;i++)
+			groupSearchTable[i] = 0;
+		searchNumber = 0;
+	}
+	searchNumber++;
 }
 
 /* -------*/
@@ -60,15 +118,7 @@ DijkstraBox::~DijkstraBox()
 /* -------*/
 int* DijkstraBox::resolveGoals(int* pLastPushPosition)
 {
-	CellList* cur = firstCell;
-	while(cur != NULL)
-	{
-		dijkstraRec(cur->pos, cur->dir, cur->value);
-		CellList* temp = cur;
-		cur = cur->next;
-		temp->next = NULL;
-		delete temp;
-	}
+	search();
 
 	const int* zToLPos = solver->getZoneToLevelPos();
 	int goalsNumber = solver->getLevel()->getGoalsNumber();
@@ -110,18 +160,74 @@ int* DijkstraBox::resolveGoals(int* pLastPushPosition)
 	return goalsValues;
 }
 
-int* DijkstraBox::resolvePositions(void)
+int* DijkstraBox::resolveKeptGoals(int* pLastPushPosition)
 {
-	CellList* cur = firstCell;
-	while(cur != NULL)
+	if(!goalsTested)
+		initKeptGoals();
+
+	int goalsNumber = solver->getLevel()->getGoalsNumber();
+	int zoneBoxPos = lToZPos[boxPos];
+	int start = getStartNeighbours();
+	int* goalsValuesTab = (int*)malloc(goalsNumber*sizeof(int));
+
+	// Same boxes on tested positions and same first pusher positions : same
+	// result
+	for(int i=0;i<KEPT_GOALS_NUMBER;i++)
 	{
-		dijkstraRec(cur->pos, cur->dir, cur->value);
-		CellList* temp = cur;
-		cur = cur->next;
-		temp->next = NULL;
-		delete temp;
+		int kept = zoneBoxPos*KEPT_GOALS_NUMBER + i;
+		Zone* tested = goalsTested[kept];
+		if(  tested && goalsStart[kept] == start
+		  && boxesZone->isEgalIn(goalsBoxes[kept], tested))
+		{
+			for(int j=0;j<goalsNumber;j++)
+			{
+				goalsValuesTab[j] = goalsValues[kept*goalsNumber+j];
+				pLastPushPosition[j] = goalsLastPositions[kept*goalsNumber+j];
+			}
+			goalsHitNumber++;
+			return goalsValuesTab;
+		}
+	}
+
+	// Compute it and keep positions tested by the search instead of oldest
+	// result of this box position
+	int kept = zoneBoxPos*KEPT_GOALS_NUMBER + goalsNext[zoneBoxPos];
+	goalsNext[zoneBoxPos] = (goalsNext[zoneBoxPos]+1)%KEPT_GOALS_NUMBER;
+
+	Zone* tested = goalsTested[kept];
+	if(tested)
+	{
+		tested->clear();
+		delete goalsBoxes[kept];
+	}
+	else
+	{
+		tested = new Zone(boxesZone->getLength());
+		goalsTested[kept] = tested;
 	}
 
+	testedZone = tested;
+	int* values = resolveGoals(pLastPushPosition);
+	testedZone = NULL;
+
+	goalsBoxes[kept] = new Zone(boxesZone);
+	goalsStart[kept] = start;
+	for(int j=0;j<goalsNumber;j++)
+	{
+		goalsValuesTab[j] = values[j];
+		goalsValues[kept*goalsNumber+j] = values[j];
+		goalsLastPositions[kept*goalsNumber+j] = pLastPushPosition[j];
+	}
+	free(values);
+	goalsMissNumber++;
+
+	return goalsValuesTab;
+}
+
+int* DijkstraBox::resolvePositions(void)
+{
+	search();
+
 	const int* zToLPos = solver->getZoneToLevelPos();
 	const int zToLPosLength = solver->getZoneToLevelPosLength();
 	int* posValues = (int*)malloc(zToLPosLength*sizeof(int));
@@ -143,8 +249,6 @@ int* DijkstraBox::resolvePositions(void)
 
 char* DijkstraBox::listMovesToPosition(int position)
 {
-	const int* lToZPos = solver->getLevelToZonePos();
-
 	// Initialization
 	char* list = (char*)malloc(sizeof(char));
 	list[0] = '\0';
@@ -187,15 +291,16 @@ char* DijkstraBox::listMovesToPosition(int position)
 			break;
 
 		// 1. Create node with current position of boxes
-		Zone* boxesZone = new Zone(node->getBoxesZone());
+		Zone* newBoxesZone = new Zone(boxesZone);
 
 		// 2. Delete initial position of box and write current position instead
-		boxesZone->write0ToPos(lToZPos[boxPos]);
-		boxesZone->write1ToPos(lToZPos[listBoxPos[i+1]]);
+		newBoxesZone->write0ToPos(lToZPos[boxPos]);
+		newBoxesZone->write1ToPos(lToZPos[listBoxPos[i+1]]);
 
 		// 3. Create new pusherZone and make a node with it
-		Zone* pusherZone = new Zone(boxesZone, listBoxPos[i], lToZPos, nCols);
-		Node* newNode = new Node(solver, pusherZone, boxesZone);
+		Zone* pusherZone = new Zone(newBoxesZone, listBoxPos[i], lToZPos,
+				nCols);
+		Node* newNode = new Node(solver, pusherZone, newBoxesZone);
 
 		// 4. Find list of moves from old pusher position to new pusher pos
 		int posA = listBoxPos[i];
@@ -217,63 +322,198 @@ char* DijkstraBox::listMovesToPosition(int position)
 	return list;
 }
 
-void DijkstraBox::dijkstraRec(int posBox, int dir, int value)
+void DijkstraBox::search(void)
 {
-	// If pos is not a wall and value is better
-	if(getPos(posBox, dir) != -1 && value < getPos(posBox, dir))
+	queueStart = 0;
+	queueEnd = 0;
+	addToQueue(boxPos, DOWN, 0);
+	addToQueue(boxPos, UP, 0);
+	addToQueue(boxPos, RIGHT, 0);
+	addToQueue(boxPos, LEFT, 0);
+
+	while(queueStart < queueEnd)
 	{
-		setPos(posBox, dir, value);
-//		print();
-
-		Zone* boxesZone = new Zone(node->getBoxesZone());
-		const int* lToZPos = solver->getLevelToZonePos();
-
-		// Delete initial position of box and write current position instead
-		boxesZone->write0ToPos(lToZPos[boxPos]);
-		boxesZone->write1ToPos(lToZPos[posBox]);
-
-		// Neighbours and opposite neighbours of the box (level representation)
-		int* lNei = (int*)malloc(4*sizeof(int));
-		int* olNei = (int*)malloc(4*sizeof(int));
-		lNei[0] = olNei[1] = posBox - 1; // Left
-		lNei[1] = olNei[0] = posBox + 1; // Right
-		lNei[2] = olNei[3] = posBox - nCols; // Up
-		lNei[3] = olNei[2] = posBox + nCols; // Down
-
-		// Neighbours and opposite neighbours of the box (zone representation)
-		int* zNei = (int*)malloc(4*sizeof(int));
-		int* ozNei = (int*)malloc(4*sizeof(int));
-		for(int i=0;i<4;i++)
-		{
-			zNei[i] = lToZPos[lNei[i]];
-			ozNei[i] = lToZPos[olNei[i]];
-		}
+		int cell = queue[queueStart];
+		queueStart++;
+
+		int posBox = cell/4;
+		int dir = cell%4;
+		int value = dTable[cell];
+
+		// Opposite neighbours of the box (level representation)
+		int olNei[4] = { posBox+1, posBox-1, posBox+nCols, posBox-nCols };
 
 		// If first iteration, we use pusherzone of node for possible moves
-		Zone* reachableZone;
 		if(value == 0)
-			reachableZone = new Zone(node->getPusherZone());
+		{
+			int start = getStartNeighbours();
+			for(int i=0;i<4;i++)
+			{
+				if(start & (1 << i))
+					addToQueue(olNei[i], i, value+1);
+			}
+		}
+		// Else pusher is behind the box (neighbour dir) and can reach
+		// neighbours of the same region
+		else
+		{
+			const int* groups = getGroups(posBox);
+			for(int i=0;i<4;i++)
+			{
+				if(groups[i] != -1 && groups[i] == groups[dir])
+					addToQueue(olNei[i], i, value+1);
+			}
+		}
+	}
+}
+
+int DijkstraBox::getStartNeighbours(void) const
+{
+	const Zone* pusher = node->getPusherZone();
+	int lNei[4] = { boxPos-1, boxPos+1, boxPos-nCols, boxPos+nCols };
+
+	// If position is reachable by pusher and is not a box
+	int start = 0;
+	for(int i=0;i<4;i++)
+	{
+		int zNei = lToZPos[lNei[i]];
+		if(zNei != -1 && pusher->readPos(zNei) && !boxesZone->readPos(zNei))
+			start |= (1 << i);
+	}
+
+	return start;
+}
+
+void DijkstraBox::initKeptGoals(void)
+{
+	int zoneLength = solver->getZoneToLevelPosLength();
+	int keptNumber = zoneLength*KEPT_GOALS_NUMBER;
+	int goalsNumber = solver->getLevel()->getGoalsNumber();
+
+	goalsTested = (Zone**)malloc(keptNumber*sizeof(Zone*));
+	goalsBoxes = (Zone**)malloc(keptNumber*sizeof(Zone*));
+	goalsStart = (int*)malloc(keptNumber*sizeof(int));
+	goalsValues = (int*)malloc(keptNumber*goalsNumber*sizeof(int));
+	goalsLastPositions = (int*)malloc(keptNumber*goalsNumber*sizeof(int));
+	goalsNext = (int*)malloc(zoneLength*sizeof(int));
+	for(int i=0;i<keptNumber;i++)
+	{
+		goalsTested[i] = NULL;
+		goalsBoxes[i] = NULL;
+	}
+	for(int i=0;i<zoneLength;i++)
+		goalsNext[i] = 0;
+}
+
+void DijkstraBox::addToQueue(int posBox, int dir, int value)
+{
+	int cell = posBox*4 + dir;
+
+	// Walls, other boxes and positions already reached are not added
+	if(searchTable[cell] == searchNumber || isBlocked(posBox))
+		return;
+
+	searchTable[cell] = searchNumber;
+	dTable[cell] = value;
+	queue[queueEnd] = cell;
+	queueEnd++;
+}
+
+const int* DijkstraBox::getGroups(int posBox)
+{
+	int* groups = &groupTab[posBox*4];
+	if(groupSearchTable[posBox] == searchNumber)
+		return groups;
+	groupSearchTable[posBox] = searchNumber;
+
+	int lNei[4] = { posBox-1, posBox+1, posBox-nCols, posBox+nCols };
+	for(int i=0;i<4;i++)
+	{
+		if(isBlocked(lNei[i]))
+			groups[i] = -1;
 		else
-			reachableZone = new Zone(boxesZone, lNei[dir], lToZPos, nCols);
+			groups[i] = i;
+	}
 
-		// If position if reachable by pusher and is not a box,
+	// Most of the time, free neighbours are linked around the box
+	if(isLocallyConnected(posBox))
+	{
 		for(int i=0;i<4;i++)
 		{
-			if(zNei[i] != -1 && reachableZone->readPos(zNei[i])
-					&& !boxesZone->readPos(zNei[i]))
+			if(groups[i] != -1)
+				groups[i] = 0;
+		}
+		return groups;
+	}
+
+	// Else, flood from each neighbour not in a previous region
+	for(int i=0;i<4;i++)
+	{
+		if(groups[i] != i)
+			continue;
+
+		int remaining = 0;
+		for(int j=i+1;j<4;j++)
+		{
+			if(groups[j] == j)
+				remaining++;
+		}
+
+		if(floodNumber == INT_MAX)
+		{
+			for(int j=0;j<nPos;j++)
+				floodTable[j] = 0;
+			floodNumber = 0;
+		}
+		floodNumber++;
+
+		// Box position is blocked
+		floodTable[posBox] = floodNumber;
+		floodTable[lNei[i]] = floodNumber;
+		floodQueue[0] = lNei[i];
+		int start = 0;
+		int end = 1;
+
+		while(start < end && remaining > 0)
+		{
+			int pos = floodQueue[start];
+			start++;
+
+			int nei[4] = { pos-1, pos+1, pos-nCols, pos+nCols };
+			for(int k=0;k<4;k++)
 			{
-				lastCell->next = new CellList(olNei[i], i, value+1, NULL);
-				lastCell = lastCell->next;
+				if(floodTable[nei[k]] == floodNumber || isBlocked(nei[k]))
+					continue;
+
+				floodTable[nei[k]] = floodNumber;
+				floodQueue[end] = nei[k];
+				end++;
+
+				for(int j=i+1;j<4;j++)
+				{
+					if(groups[j] == j && lNei[j] == nei[k])
+					{
+						groups[j] = i;
+						remaining--;
+					}
+				}
 			}
 		}
-
-		delete reachableZone;
-		delete boxesZone;
-		free(lNei);
-		free(olNei);
-		free(zNei);
-		free(ozNei);
 	}
+
+	return groups;
+}
+
+bool DijkstraBox::isLocallyConnected(int posBox)
+{
+	int around[8];
+	Zone::getAroundPositions(posBox, nCols, around);
+
+	bool freeTab[8];
+	for(int i=0;i<8;i++)
+		freeTab[i] = !isBlocked(around[i]);
+
+	return Zone::isAroundConnected(freeTab);
 }
 
 void DijkstraBox::print()
@@ -0,0 +1,313 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../include/Solver/GoalRoom.h"
+
+GoalRoom::GoalRoom(const Solver* solver):
+	solver(solver),
+	length(solver->getZoneToLevelPosLength()),
+	nCols(solver->getLevel()->getColsNumber()),
+	roomZone(NULL),
+	entrance(-1),
+	packingOrder(NULL),
+	packingLength(0),
+	packingRank(NULL),
+	floodQueue(NULL),
+	floodTable(NULL),
+	floodNumber(0),
+	pullQueue(NULL),
+	pullTable(NULL),
+	pullSearchTable(NULL),
+	pullNumber(0)
+{
+	floodQueue = (int*)malloc(length*sizeof(int));
+	floodTable = (int*)malloc(length*sizeof(int));
+	pullQueue = (int*)malloc(4*length*sizeof(int));
+	pullTable = (int*)malloc(4*length*sizeof(int));
+	pullSearchTable = (int*)malloc(4*length*sizeof(int));
+	for(int i=0;i<length;i++)
+		floodTable[i] = 0;
+	for(int i=0;i<4*length;i++)
+		pullSearchTable[i] = 0;
+
+	packingOrder = (int*)malloc(
+			(solver->getLevel()->getGoalsNumber()+1)*sizeof(int));
+	packingRank = (int*)malloc(length*sizeof(int));
+	for(int i=0;i<length;i++)
+		packingRank[i] = -1;
+
+	if(solver->usesPackingOrder())
+	{
+		findRoom();
+		findPackingOrder();
+	}
+
+	// Tables of searches are only used to find the order
+	free(floodQueue);
+	free(floodTable);
+	free(pullQueue);
+	free(pullTable);
+	free(pullSearchTable);
+	floodQueue = NULL;
+	floodTable = NULL;
+	pullQueue = NULL;
+	pullTable = NULL;
+	pullSearchTable = NULL;
+}
+
+GoalRoom::~GoalRoom()
+{
+	if(roomZone)
+		delete roomZone;
+	free(packingOrder);
+	free(packingRank);
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+int GoalRoom::getPackedNumber(const Zone* boxesZone) const
+{
+	int packedNumber = getFollowedNumber(boxesZone);
+	if(packedNumber == -1)
+		return 0;
+	return packedNumber;
+}
+
+int GoalRoom::getFollowedNumber(const Zone* boxesZone) const
+{
+	if(packingLength == 0)
+		return -1;
+
+	int packedNumber = 0;
+	while(  packedNumber < packingLength
+		 && boxesZone->readPos(packingOrder[packedNumber]) == 1)
+		packedNumber++;
+
+	// Order is not followed if another box is in the room
+	int roomBoxes = 0;
+	for(int i=0;i<length;i++)
+	{
+		if(roomZone->readPos(i) == 1 && boxesZone->readPos(i) == 1)
+			roomBoxes++;
+	}
+	if(roomBoxes != packedNumber)
+		return -1;
+
+	return packedNumber;
+}
+
+void GoalRoom::findRoom(void)
+{
+	const Zone* goalZone = solver->getGoalZone();
+	const int* goalsPositions = solver->getGoalsPositions();
+	int goalsNumber = solver->getLevel()->getGoalsNumber();
+	if(goalsNumber == 0)
+		return;
+
+	// An entrance is a bounded position (walls on both sides) that separates
+	// goals from at least one box. Smallest room is kept.
+	int roomSize = length-1;
+	for(int i=0;i<length;i++)
+	{
+		if(goalZone->readPos(i) == 1 || !isBoundedPos(i))
+			continue;
+
+		int size = flood(goalsPositions[0], NULL, i);
+		if(size >= roomSize)
+			continue;
+
+		bool everyGoal = true;
+		for(int j=1;j<goalsNumber && everyGoal;j++)
+			everyGoal = (floodTable[goalsPositions[j]] == floodNumber);
+
+		if(everyGoal && hasBoxOutside())
+		{
+			roomSize = size;
+			entrance = i;
+		}
+	}
+
+	if(entrance == -1)
+		return;
+
+	flood(goalsPositions[0], NULL, entrance);
+	roomZone = new Zone(length);
+	for(int i=0;i<length;i++)
+	{
+		if(floodTable[i] == floodNumber)
+			roomZone->write1ToPos(i);
+	}
+}
+
+void GoalRoom::findPackingOrder(void)
+{
+	const int* goalsPositions = solver->getGoalsPositions();
+	int goalsNumber = solver->getLevel()->getGoalsNumber();
+	if(entrance == -1 || solver->getLevel()->getBoxesNumber() != goalsNumber)
+		return;
+
+	// Room is full, boxes are pulled out one after another. Last pulled out
+	// box is the first one to push in.
+	Zone* boxes = new Zone(solver->getGoalZone());
+	for(int k=goalsNumber-1;k>=0;k--)
+	{
+		int bestGoal = -1;
+		int bestPulls = INT_MAX;
+		for(int i=0;i<goalsNumber;i++)
+		{
+			int goal = goalsPositions[i];
+			if(boxes->readPos(goal) == 0)
+				continue;
+
+			boxes->write0ToPos(goal);
+			int pulls = pullOut(boxes, goal);
+			boxes->write1ToPos(goal);
+
+			if(pulls != -1 && pulls < bestPulls)
+			{
+				bestPulls = pulls;
+				bestGoal = goal;
+			}
+		}
+
+		// A box can't be taken out : no order
+		if(bestGoal == -1)
+		{
+			delete boxes;
+			return;
+		}
+
+		boxes->write0ToPos(bestGoal);
+		packingOrder[k] = bestGoal;
+	}
+	delete boxes;
+
+	packingLength = goalsNumber;
+	for(int i=0;i<packingLength;i++)
+		packingRank[packingOrder[i]] = i;
+}
+
+bool GoalRoom::isBoundedPos(int zonePos) const
+{
+	int left = getNeighbour(zonePos, 0);
+	int right = getNeighbour(zonePos, 1);
+	int up = getNeighbour(zonePos, 2);
+	int down = getNeighbour(zonePos, 3);
+
+	// Horizontal passage (walls up and down) or vertical one
+	if(left != -1 && right != -1 && up == -1 && down == -1)
+		return true;
+	return (up != -1 && down != -1 && left == -1 && right == -1);
+}
+
+bool GoalRoom::hasBoxOutside(void) const
+{
+	const Level* level = solver->getLevel();
+	const int* zToLPos = solver->getZoneToLevelPos();
+	for(int i=0;i<length;i++)
+	{
+		char c = level->readPos(zToLPos[i]);
+		if((c == '$' || c == '*') && floodTable[i] != floodNumber)
+			return true;
+	}
+
+	return false;
+}
+
+int GoalRoom::pullOut(const Zone* boxes, int boxPos)
+{
+	const Zone* deadSquareZone = solver->getDeadSquareZone();
+
+	pullNumber++;
+	int queueStart = 0;
+	int queueEnd = 0;
+
+	// Pusher comes in the room by the entrance
+	flood(entrance, boxes, boxPos);
+	for(int dir=0;dir<4;dir++)
+	{
+		int pusherPos = getNeighbour(boxPos, dir);
+		if(pusherPos != -1 && floodTable[pusherPos] == floodNumber)
+		{
+			int state = boxPos*4 + dir;
+			pullSearchTable[state] = pullNumber;
+			pullTable[state] = 0;
+			pullQueue[queueEnd] = state;
+			queueEnd++;
+		}
+	}
+
+	while(queueStart < queueEnd)
+	{
+		int state = pullQueue[queueStart];
+		queueStart++;
+		int pos = state/4;
+		int pulls = pullTable[state] + 1;
+
+		// Box is pulled to a position the pusher reaches and pusher moves
+		// one more position in the same direction
+		flood(getNeighbour(pos, state%4), boxes, pos);
+		for(int dir=0;dir<4;dir++)
+		{
+			int newPos = getNeighbour(pos, dir);
+			if(newPos == -1 || floodTable[newPos] != floodNumber)
+				continue;
+			int pusherPos = getNeighbour(newPos, dir);
+			if(pusherPos == -1 || boxes->readPos(pusherPos) == 1)
+				continue;
+			if(  deadSquareZone->readPos(newPos) == 1
+			  || (newPos != entrance && roomZone->readPos(newPos) == 0))
+				continue;
+
+			// Out of the room
+			if(newPos == entrance && roomZone->readPos(pusherPos) == 0)
+				return pulls;
+
+			int newState = newPos*4 + dir;
+			if(pullSearchTable[newState] != pullNumber)
+			{
+				pullSearchTable[newState] = pullNumber;
+				pullTable[newState] = pulls;
+				pullQueue[queueEnd] = newState;
+				queueEnd++;
+			}
+		}
+	}
+
+	return -1;
+}
+
+int GoalRoom::flood(int startPos, const Zone* boxes, int forbiddenPos)
+{
+	floodNumber++;
+	int queueStart = 0;
+	int queueEnd = 1;
+	floodQueue[0] = startPos;
+	floodTable[startPos] = floodNumber;
+
+	while(queueStart < queueEnd)
+	{
+		int pos = floodQueue[queueStart];
+		queueStart++;
+		for(int dir=0;dir<4;dir++)
+		{
+			int neighbour = getNeighbour(pos, dir);
+			if(  neighbour == -1 || neighbour == forbiddenPos
+			  || floodTable[neighbour] == floodNumber
+			  || (boxes && boxes->readPos(neighbour) == 1))
+				continue;
+
+			floodTable[neighbour] = floodNumber;
+			floodQueue[queueEnd] = neighbour;
+			queueEnd++;
+		}
+	}
+
+	return queueEnd;
+}
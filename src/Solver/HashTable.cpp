@@ -94,19 +94,36 @@ TreeNode* HashTable::getTreeNodeFromNode(const Node* node)
 	return NULL;
 }
 
+TreeNode* HashTable::getTreeNodeFromState(const Zone* boxesZone,
+		int pusherPos)
+{
+	int pos = h(boxesZone);
+	ListNode * cur = table[pos]->getFirstItem();
+	while(cur != NULL)
+	{
+		Node* node = cur->getNode();
+		if(  node->getPusherZone()->readPos(pusherPos) == 1
+		  && node->getBoxesZone()->isEgal(boxesZone))
+			return cur->getTreeNode();
+		cur = cur->getNext();
+	}
+
+	return NULL;
+}
+
 int HashTable::h(const Node* node) const
 {
-	int sum = 0;
-	Zone* boxes = node->getBoxesZone();
-	Zone* pusher = node->getPusherZone();
+	return h(node->getBoxesZone());
+}
 
-	// We suppose both zones have the same size
-	int cellNumber = boxes->getNumberCell();
+int HashTable::h(const Zone* boxesZone) const
+{
+	int sum = 0;
+	int cellNumber = boxesZone->getNumberCell();
 
 	for(int i=0;i<cellNumber;i++)
 	{
-		sum += boxes->getZoneTab()[i]%length;
-		sum += pusher->getZoneTab()[i]%length;
+		sum += boxesZone->getZoneTab()[i]%length;
 		sum = sum%length;
 	}
 
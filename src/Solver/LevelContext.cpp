@@ -0,0 +1,87 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../include/Solver/LevelContext.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+LevelContext::LevelContext(const Solver* solver):
+	zoneToLevelPos(NULL),
+	zoneToLevelPosLength(solver->getZoneToLevelPosLength()),
+	levelToZonePos(NULL),
+	levelToZonePosLength(solver->getLevel()->getRowsNumber()
+			*solver->getLevel()->getColsNumber()),
+	goalZone(NULL),
+	goalsPositions(NULL),
+	goalsNumber(solver->getLevel()->getGoalsNumber()),
+	deadSquareZone(NULL),
+	zoneToBoxPos(NULL),
+	boxToZonePos(NULL),
+	boxToZonePosLength(solver->getBoxToZonePosLength()),
+	tunnelTab(NULL),
+	costTable(NULL)
+{
+	zoneToLevelPos = (int*)malloc(zoneToLevelPosLength*sizeof(int));
+	memcpy(zoneToLevelPos, solver->getZoneToLevelPos(),
+			zoneToLevelPosLength*sizeof(int));
+
+	levelToZonePos = (int*)malloc(levelToZonePosLength*sizeof(int));
+	memcpy(levelToZonePos, solver->getLevelToZonePos(),
+			levelToZonePosLength*sizeof(int));
+
+	goalZone = new Zone(solver->getGoalZone());
+	goalsPositions = (int*)malloc(goalsNumber*sizeof(int));
+	memcpy(goalsPositions, solver->getGoalsPositions(),
+			goalsNumber*sizeof(int));
+
+	deadSquareZone = new Zone(solver->getDeadSquareZone());
+	zoneToBoxPos = (int*)malloc(zoneToLevelPosLength*sizeof(int));
+	memcpy(zoneToBoxPos, solver->getZoneToBoxPos(),
+			zoneToLevelPosLength*sizeof(int));
+	boxToZonePos = (int*)malloc(zoneToLevelPosLength*sizeof(int));
+	memcpy(boxToZonePos, solver->getBoxToZonePos(),
+			boxToZonePosLength*sizeof(int));
+
+	tunnelTab = (bool*)malloc(2*zoneToLevelPosLength*sizeof(bool));
+	memcpy(tunnelTab, solver->getTunnelTab(),
+			2*zoneToLevelPosLength*sizeof(bool));
+
+	const int* const* solverCostTable = solver->getCostTable();
+	if(solverCostTable)
+	{
+		costTable = (int**)malloc(boxToZonePosLength*sizeof(int*));
+		for(int i=0;i<boxToZonePosLength;i++)
+		{
+			costTable[i] = (int*)malloc(zoneToLevelPosLength*sizeof(int));
+			memcpy(costTable[i], solverCostTable[i],
+					zoneToLevelPosLength*sizeof(int));
+		}
+	}
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+LevelContext::~LevelContext()
+{
+	free(zoneToLevelPos);
+	free(levelToZonePos);
+	delete goalZone;
+	free(goalsPositions);
+	delete deadSquareZone;
+	free(zoneToBoxPos);
+	free(boxToZonePos);
+	free(tunnelTab);
+	if(costTable)
+	{
+		for(int i=0;i<boxToZonePosLength;i++)
+			free(costTable[i]);
+		free(costTable);
+	}
+}
@@ -74,38 +74,43 @@ bool Node::isSolution(void) const
 
 Node** Node::findChildren(void) const
 {
-	// Position of neighbours of processed cell
-	int pos, posLeft, posRight, posUp, posDown;
+	Push* pushes = (Push*)malloc((4*boxesZone->getNumberOf1()+1)*sizeof(Push));
+	int pushNumber = findPushes(pushes, NULL);
+
+	Node** children = (Node**)malloc((pushNumber+1)*sizeof(Node*));
+	for(int i=0;i<pushNumber;i++)
+		children[i] = createChild(&pushes[i]);
+	children[pushNumber] = NULL;
 
-	// Neighbours zones to be assigned if not NULL at the end of the loop
-	Zone *leftMovePusherZone, *leftMoveBoxesZone;
-	Zone *rightMovePusherZone, *rightMoveBoxesZone;
-	Zone *upMovePusherZone, *upMoveBoxesZone;
-	Zone *downMovePusherZone, *downMoveBoxesZone;
+	free(pushes);
 
-	// Initialization of children list
-	int nChildren = 0;
-	Node** children = (Node**)malloc((nChildren + 1)*sizeof(Node*));
-	children[nChildren] = NULL;
+	return children;
+}
+
+int Node::findPushes(Push* pushes, const Zone* forbiddenZone) const
+{
+	// Position of neighbours of processed cell
+	int pos, posLeft, posRight, posUp, posDown;
 
 	const int* LtoZPos = solver->getLevelToZonePos();
 	const int* ZtoLPos = solver->getZoneToLevelPos();
 	const int levelColsNumber = solver->getLevel()->getColsNumber();
 
-	// Create a zone with every boxes the pusher can reach
-	Zone* accessibleBoxes = new Zone(pusherZone, boxesZone, Zone::USE_AND);
-	int length = accessibleBoxes->getLength();
+	const unsigned int* boxesTab = boxesZone->getZoneTab();
+	const unsigned int* pusherTab = pusherZone->getZoneTab();
+	const int cellSize = 8*sizeof(unsigned int);
+	int nCells = boxesZone->getNumberCell();
+	int pushNumber = 0;
 
-	// For each bit
-	for(int i=0;i<length;i++)
+	for(int k=0;k<nCells;k++)
 	{
-		// If there is a box in this position that can be reached
-		if(accessibleBoxes->readPos(i) == 1)
+		// Boxes of this cell that can be reached (first position is high bit)
+		unsigned int reached = boxesTab[k] & pusherTab[k];
+		while(reached != 0)
 		{
-			leftMovePusherZone = leftMoveBoxesZone = NULL;
-			rightMovePusherZone = rightMoveBoxesZone = NULL;
-			upMovePusherZone = upMoveBoxesZone = NULL;
-			downMovePusherZone = downMoveBoxesZone = NULL;
+			int bitPos = __builtin_clz(reached);
+			reached &= ~((unsigned int)1 << (cellSize-1-bitPos));
+			int i = k*cellSize+bitPos;
 
 			pos = ZtoLPos[i];
 			// Positions in "level" representation
@@ -118,119 +123,86 @@ Node** Node::findChildren(void) const
 			if(posLeft != -1 && posRight != -1)
 			{
 				// If you can push the box from left to right
-				if( pusherZone->readPos(posLeft)
-				&& !boxesZone->readPos(posLeft)
-				&& !boxesZone->readPos(posRight))
-				{
-					// Create corresponding new Zones
-					rightMoveBoxesZone = new Zone(this->boxesZone);
-					rightMoveBoxesZone->write1ToPos(posRight);
-					rightMoveBoxesZone->write0ToPos(i);
-
-					rightMovePusherZone = new Zone(rightMoveBoxesZone, pos,
-							LtoZPos, levelColsNumber);
-
-					// Add children to the list
-					nChildren++;
-					children = (Node**)realloc(children,
-											   (nChildren + 1)*sizeof(Node*));
-					children[nChildren] = NULL;
-					children[nChildren-1] = new Node(solver);
-					children[nChildren-1]->setBoxesZone(rightMoveBoxesZone);
-					children[nChildren-1]->setPusherZone(rightMovePusherZone);
-				}
+				if(canPush(posLeft, posRight, forbiddenZone))
+					setPush(&pushes[pushNumber++], i, posRight, pos, 'R');
 				// If you can push the box from right to left
-				if( pusherZone->readPos(posRight)
-				&& !boxesZone->readPos(posRight)
-				&& !boxesZone->readPos(posLeft))
-				{
-					// Create corresponding new Zones
-					leftMoveBoxesZone = new Zone(this->boxesZone);
-					leftMoveBoxesZone->write1ToPos(posLeft);
-					leftMoveBoxesZone->write0ToPos(i);
-
-					leftMovePusherZone = new Zone(leftMoveBoxesZone, pos,
-							LtoZPos, levelColsNumber);
-
-					// Add children to the list
-					nChildren++;
-					children = (Node**)realloc(children,
-											   (nChildren + 1)*sizeof(Node*));
-					children[nChildren] = NULL;
-					children[nChildren-1] = new Node(solver);
-					children[nChildren-1]->setBoxesZone(leftMoveBoxesZone);
-					children[nChildren-1]->setPusherZone(leftMovePusherZone);
-				}
+				if(canPush(posRight, posLeft, forbiddenZone))
+					setPush(&pushes[pushNumber++], i, posLeft, pos, 'L');
 			}
 			if(posUp != -1 && posDown != -1)
 			{
 				// If you can push the box from up to down
-				if( pusherZone->readPos(posUp)
-				&& !boxesZone->readPos(posUp)
-				&& !boxesZone->readPos(posDown))
-				{
-					// Create corresponding new Zones
-					downMoveBoxesZone = new Zone(this->boxesZone);
-					downMoveBoxesZone->write1ToPos(posDown);
-					downMoveBoxesZone->write0ToPos(i);
-
-					downMovePusherZone = new Zone(downMoveBoxesZone, pos,
-							LtoZPos, levelColsNumber);
-
-					// Add children to the list
-					nChildren++;
-					children = (Node**)realloc(children,
-											   (nChildren + 1)*sizeof(Node*));
-					children[nChildren] = NULL;
-					children[nChildren-1] = new Node(solver);
-					children[nChildren-1]->setBoxesZone(downMoveBoxesZone);
-					children[nChildren-1]->setPusherZone(downMovePusherZone);
-				}
+				if(canPush(posUp, posDown, forbiddenZone))
+					setPush(&pushes[pushNumber++], i, posDown, pos, 'D');
 				// If you can push the box from down to up
-				if( pusherZone->readPos(posDown)
-				&& !boxesZone->readPos(posDown)
-				&& !boxesZone->readPos(posUp))
-				{
-					// Create corresponding new Zones
-					upMoveBoxesZone = new Zone(this->boxesZone);
-					upMoveBoxesZone->write1ToPos(posUp);
-					upMoveBoxesZone->write0ToPos(i);
-
-					upMovePusherZone = new Zone(upMoveBoxesZone, pos,
-							LtoZPos, levelColsNumber);
-
-					// Add children to the list
-					nChildren++;
-					children = (Node**)realloc(children,
-											   (nChildren + 1)*sizeof(Node*));
-					children[nChildren] = NULL;
-					children[nChildren-1] = new Node(solver);
-					children[nChildren-1]->setBoxesZone(upMoveBoxesZone);
-					children[nChildren-1]->setPusherZone(upMovePusherZone);
-				}
+				if(canPush(posDown, posUp, forbiddenZone))
+					setPush(&pushes[pushNumber++], i, posUp, pos, 'U');
 			}
 		}
 	}
 
-	delete accessibleBoxes;
+	return pushNumber;
+}
 
-	return children;
+void Node::applyTunnel(Push* push) const
+{
+	const int* LtoZPos = solver->getLevelToZonePos();
+	const Zone* goalZone = solver->getGoalZone();
+	const Zone* deadSquareZone = solver->getDeadSquareZone();
+
+	int boxPos = solver->getZoneToLevelPos()[push->boxNewPosition];
+	int step = boxPos - push->pusherNewPosition;
+	bool horizontal = (step == 1 || step == -1);
+
+	while(   goalZone->readPos(push->boxNewPosition) == 0
+		  && solver->isTunnel(push->boxNewPosition, horizontal)
+		  && solver->isTunnel(LtoZPos[push->pusherNewPosition], horizontal))
+	{
+		int next = LtoZPos[boxPos+step];
+		if(  next == -1 || boxesZone->readPos(next) == 1
+		  || deadSquareZone->readPos(next) == 1)
+			break;
+
+		push->pusherNewPosition = boxPos;
+		push->boxNewPosition = next;
+		push->pushCost++;
+		boxPos += step;
+	}
 }
 
-Child** Node::findMacroChildren(Node** nodeList)
+Node* Node::createChild(const Push* push) const
 {
-	// Get some informations on nodes already present into the list
-	// and initialize their gCost to 1 (no macro : simple push)
-	int nodeListLength = 0;
-	while(nodeList != NULL && nodeList[nodeListLength] != NULL)
-		nodeListLength++;
-
-	Child** children = (Child**)malloc((nodeListLength+1)*sizeof(Child*));
-	for(int i=0;i<nodeListLength;i++)
-		children[i] = new Child(nodeList[i], 0);
-	children[nodeListLength] = NULL;
-	free(nodeList);
+	Zone* childBoxesZone = new Zone(boxesZone);
+	childBoxesZone->write1ToPos(push->boxNewPosition);
+	childBoxesZone->write0ToPos(push->boxOldPosition);
 
+	// Pusher zone of this node updated around the pushed box (made again
+	// if box went through a tunnel)
+	Zone* childPusherZone;
+	const int* LtoZPos = solver->getLevelToZonePos();
+	int nCols = solver->getLevel()->getColsNumber();
+	if(push->pushCost == 1)
+		childPusherZone = new Zone(pusherZone, childBoxesZone,
+				push->pusherNewPosition,
+				solver->getZoneToLevelPos()[push->boxNewPosition],
+				LtoZPos, nCols);
+	else
+		childPusherZone = new Zone(childBoxesZone, push->pusherNewPosition,
+				LtoZPos, nCols);
+
+	return new Node(solver, childPusherZone, childBoxesZone);
+}
+
+void Node::writeChildBoxes(const Push* push, Zone* childBoxesZone) const
+{
+	childBoxesZone->clear();
+	childBoxesZone->applyOrWith(boxesZone);
+	childBoxesZone->write0ToPos(push->boxOldPosition);
+	childBoxesZone->write1ToPos(push->boxNewPosition);
+}
+
+Child** Node::findMacroChildren(const Push* pushes, int pushNumber)
+{
 	Macro** macroList = (Macro**)malloc(sizeof(Macro*));
 	int macroListLength = 0;
 
@@ -244,19 +216,22 @@ Child** Node::findMacroChildren(Node** nodeList)
 	// priority goal
 	int* costOfGoals = computeCostOfGoals(this);
 
-	// Create a zone with every boxes the pusher can reach
-	Zone* accessibleBoxes = new Zone(pusherZone, boxesZone, Zone::USE_AND);
+	// If goal room is filled in order, packed boxes are not moved again
+	const GoalRoom* goalRoom = solver->getGoalRoom();
+	int packedNumber = goalRoom->getPackedNumber(boxesZone);
 
-	// Test each accessible box of this node and save
+	// Test each box the pusher can reach and save
 	// every possible macro informations
-	int length = accessibleBoxes->getLength();
+	int length = boxesZone->getLength();
 	for(int i=0;i<length;i++)
 	{
-		if(accessibleBoxes->readPos(i) == 1)
+		if(  boxesZone->readPos(i) == 1 && pusherZone->readPos(i) == 1
+		  && !goalRoom->isPacked(i, packedNumber))
 		{
-			DijkstraBox* dBox = new DijkstraBox(solver, this, zToLPos[i]);
+			DijkstraBox* dBox = solver->getDijkstraBox();
+			dBox->setBox(this, zToLPos[i]);
 			int* lastPositions = (int*)malloc(numOfGoals*sizeof(int));
-			int* numOfPushes = dBox->resolveGoals(lastPositions);
+			int* numOfPushes = dBox->resolveKeptGoals(lastPositions);
 
 			for(int j=0;j<numOfGoals;j++)
 			{
@@ -279,22 +254,38 @@ Child** Node::findMacroChildren(Node** nodeList)
 				}
 			}
 
-			delete dBox;
 			free(numOfPushes);
 			free(lastPositions);
 		}
 	}
 
-	delete accessibleBoxes;
-
 	// Now we have all macro informations we want
 	// We choose to keep only nodes with box on goals with maximum costs.
 	int maxGoalCost = 0;
+	int keptMacroNumber = 0;
 	for(int i=0;i<macroListLength;i++)
 	{
 		if(macroList[i]->costOfGoal > maxGoalCost)
+		{
 			maxGoalCost = macroList[i]->costOfGoal;
+			keptMacroNumber = 0;
+		}
+		if(macroList[i]->costOfGoal == maxGoalCost)
+			keptMacroNumber++;
+	}
+
+	// Simple pushes first (cost 0 : no macro), then kept macro-pushes
+	Child** children = (Child**)malloc(
+			(pushNumber+keptMacroNumber+1)*sizeof(Child*));
+	for(int i=0;i<pushNumber;i++)
+	{
+		// Cost 0 is a simple push
+		int childCost = 0;
+		if(pushes[i].pushCost > 1)
+			childCost = pushes[i].pushCost;
+		children[i] = new Child(createChild(&pushes[i]), childCost);
 	}
+	int childNumber = pushNumber;
 
 	for(int i=0;i<macroListLength;i++)
 	{
@@ -309,14 +300,12 @@ Child** Node::findMacroChildren(Node** nodeList)
 			Node* newNode = new Node(solver, newPusherZone, newBoxesZone);
 
 			// Save new node
-			nodeListLength++;
-			children = (Child**)realloc(children,
-									  (nodeListLength+1)*sizeof(Child*));
-			children[nodeListLength-1] = new Child(newNode,
+			children[childNumber] = new Child(newNode,
 					macroList[i]->numberOfPushes);
-			children[nodeListLength] = NULL;
+			childNumber++;
 		}
 	}
+	children[childNumber] = NULL;
 
 	for(int i=0;i<macroListLength;i++)
 		delete macroList[i];
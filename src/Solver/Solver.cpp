@@ -13,6 +13,10 @@
 #include "../../include/Solver/Node.h"
 #include "../../include/Solver/Stats.h"
 #include "../../include/Solver/Deadlock.h"
+#include "../../include/Solver/VerdictCache.h"
+#include "../../include/Solver/DijkstraBox.h"
+#include "../../include/Solver/GoalRoom.h"
+#include "../../include/Solver/LevelContext.h"
 
 /* ------------*/
 /* Constructor */
@@ -28,11 +32,24 @@ Solver::Solver(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
 	closeTable(NULL),
 	closeNodeList(NULL),
 	deadlockEngine(NULL),
+	verdictCache(NULL),
+	sharedVerdictCache(false),
+	levelContext(NULL),
+	sharedLevelContext(false),
 	goalZone(NULL),
 	goalsPositions(NULL),
 	zoneToLevelPos(NULL),
 	zoneToLevelPosLength(0),
 	levelToZonePos(NULL),
+	deadSquareZone(NULL),
+	zoneToBoxPos(NULL),
+	boxToZonePos(NULL),
+	boxToZonePosLength(0),
+	pushes(NULL),
+	pushBoxesZone(NULL),
+	dijkstraBox(NULL),
+	goalRoom(NULL),
+	tunnelTab(NULL),
 	nodeNumber(0),
 	maxNodeNumber(maxNodeNumber),
 	ramSize(0),
@@ -44,6 +61,8 @@ Solver::Solver(Base* base, Level* level, int maxNodeNumber, int maxRamSize,
 {
 	OPENTABLE_SIZE = openTableSize;
 	CLOSETABLE_SIZE = closeTableSize;
+
+	dijkstraBox = new DijkstraBox(this);
 }
 
 /* -----------*/
@@ -67,14 +86,59 @@ Solver::~Solver()
 		delete closeNodeList;
 	if(deadlockEngine)
 		delete deadlockEngine;
-	if(goalZone)
-		delete goalZone;
-	if(goalsPositions)
-		free(goalsPositions);
-	if(levelToZonePos)
-		free(levelToZonePos);
-	if(zoneToLevelPos)
-		free(zoneToLevelPos);
+	if(verdictCache && !sharedVerdictCache)
+		delete verdictCache;
+	// Tables of a shared context are deleted by their owner
+	if(!sharedLevelContext)
+	{
+		if(levelContext)
+			delete levelContext;
+		if(goalZone)
+			delete goalZone;
+		if(goalsPositions)
+			free((int*)goalsPositions);
+		if(levelToZonePos)
+			free((int*)levelToZonePos);
+		if(zoneToLevelPos)
+			free((int*)zoneToLevelPos);
+		if(deadSquareZone)
+			delete deadSquareZone;
+		if(zoneToBoxPos)
+			free((int*)zoneToBoxPos);
+		if(boxToZonePos)
+			free((int*)boxToZonePos);
+		if(tunnelTab)
+			free((bool*)tunnelTab);
+	}
+	if(pushes)
+		free(pushes);
+	if(pushBoxesZone)
+		delete pushBoxesZone;
+	if(dijkstraBox)
+		delete dijkstraBox;
+	if(goalRoom)
+		delete goalRoom;
+}
+
+/* --------*/
+/* Setters */
+/* --------*/
+void Solver::setVerdictCache(VerdictCache* verdictCache)
+{
+	if(this->verdictCache && !sharedVerdictCache)
+		delete this->verdictCache;
+
+	this->verdictCache = verdictCache;
+	sharedVerdictCache = true;
+}
+
+void Solver::setLevelContext(LevelContext* levelContext)
+{
+	if(this->levelContext && !sharedLevelContext)
+		delete this->levelContext;
+
+	this->levelContext = levelContext;
+	sharedLevelContext = true;
 }
 
 /* -------*/
@@ -202,12 +266,10 @@ int Solver::getSize(void)
 
 void Solver::initialize(void)
 {
-	// Create translation tables between zone and level
-	initZoneToLevelPos();
-	initLevelToZonePos();
-
-	// Initialize fixed deadlock and goals Zones
-	initGoalZone();
+	// Create translation tables, fixed deadlock and goals Zones
+	initLevelTables();
+	initPushes();
+	initGoalRoom();
 	initDeadlockEngine();
 
 	// Initialize hash table
@@ -224,7 +286,7 @@ void Solver::process()
 {
 	int i;
 	TreeNode* treeNode = NULL;
-	Node** children = NULL;
+	int pushNumber = 0;
 	bool deadlockednode;
 	bool alreadysearched;
 	bool stopped = false; // stopped is true if limit reached
@@ -244,41 +306,47 @@ void Solver::process()
 		// Find every children of this node
 		if(!solved)
 		{
-			children = findChildren(treeNode);
+			pushNumber = findPushes(treeNode);
 			printInfos(treeNode);
 		}
 
 		// We test every found children
 		i=0;
-		while(!solved && children != NULL && children[i] != NULL)
+		while(!solved && i < pushNumber)
 		{
-			// Create a treeNode and attach it to its parent treeNode
-			TreeNode* childrenI = createTreeNode(children[i], treeNode, 0);
+			// Tests made on boxes of the push before creating its node
+			treeNode->getNode()->writeChildBoxes(&pushes[i], pushBoxesZone);
 
 			// If node already present in open or close hashtable
-			alreadysearched = isAlreadySearched(children[i]);
+			alreadysearched = isAlreadySearched(pushBoxesZone,
+					levelToZonePos[pushes[i].pusherNewPosition]);
 
 			if(!alreadysearched)
-				deadlockednode = deadlockEngine->deadlockedNode(childrenI);
+				deadlockednode = deadlockEngine->deadlockedPush(pushBoxesZone,
+						zoneToLevelPos[pushes[i].boxNewPosition]);
 
-			// If not deadlocked and not already present in the hashTable
 			if(!alreadysearched && !deadlockednode)
 			{
-				// If stop condition, we continue close list until it's empty
-				if(!stopped)
+				// Create a treeNode and attach it to its parent treeNode
+				Node* child = treeNode->getNode()->createChild(&pushes[i]);
+				TreeNode* childrenI = createTreeNode(child, treeNode, 0);
+
+				deadlockednode = deadlockEngine->deadlockedNode(childrenI);
+
+				// If not deadlocked and not already present in the hashTable
+				// (if stop condition, we continue close list until it's
+				// empty)
+				if(!deadlockednode && !stopped)
 				{
 					addTreeNodeToCloseList(childrenI);
 					closeTable->addItem(childrenI);
 				}
+				else
+					delete childrenI;
 			}
-			else
-				delete childrenI;
 
 			i++;
 		}
-
-		if(!solved && children != NULL)
-			free(children);
 	}
 
 	if(nodeNumber>maxNodeNumber || getSize()>maxRamSize*1048576)
@@ -311,28 +379,54 @@ TreeNode* Solver::firstTreeNode(void)
 	}
 }
 
-Node** Solver::findChildren(TreeNode* treeNode)
+int Solver::findPushes(TreeNode* treeNode)
 {
 	if(treeNode)
 	{
 		closeTable->removeItem(treeNode->getNode());
 		openTable->addItem(treeNode);
-		return treeNode->getNode()->findChildren();
+		return treeNode->getNode()->findPushes(pushes, deadSquareZone);
 	}
 	else
-		return NULL;
+		return 0;
 }
 
-bool Solver::isAlreadySearched(Node* node)
+bool Solver::isAlreadySearched(const Zone* boxesZone, int pusherPos)
 {
 	return
-	(openTable->isPresent(node) || closeTable->isPresent(node));
+	(  openTable->getTreeNodeFromState(boxesZone, pusherPos) != NULL
+	|| closeTable->getTreeNodeFromState(boxesZone, pusherPos) != NULL);
+}
+
+void Solver::initLevelTables(void)
+{
+	if(levelContext)
+	{
+		zoneToLevelPos = levelContext->getZoneToLevelPos();
+		zoneToLevelPosLength = levelContext->getZoneToLevelPosLength();
+		levelToZonePos = levelContext->getLevelToZonePos();
+		goalZone = levelContext->getGoalZone();
+		goalsPositions = levelContext->getGoalsPositions();
+		deadSquareZone = levelContext->getDeadSquareZone();
+		zoneToBoxPos = levelContext->getZoneToBoxPos();
+		boxToZonePos = levelContext->getBoxToZonePos();
+		boxToZonePosLength = levelContext->getBoxToZonePosLength();
+		tunnelTab = levelContext->getTunnelTab();
+	}
+	else
+	{
+		initZoneToLevelPos();
+		initLevelToZonePos();
+		initGoalZone();
+		initBoxToZonePos();
+		initTunnels();
+	}
 }
 
 void Solver::initZoneToLevelPos(void)
 {
 	int length = 0;
-	this->zoneToLevelPos = (int*)malloc(1*sizeof(int));
+	int* zoneToLevelPos = (int*)malloc(1*sizeof(int));
 
 	int m = this->level->getRowsNumber();
 	int n = this->level->getColsNumber();
@@ -349,6 +443,7 @@ void Solver::initZoneToLevelPos(void)
 		}
 	}
 
+	this->zoneToLevelPos = zoneToLevelPos;
 	this->zoneToLevelPosLength = length;
 }
 
@@ -356,13 +451,15 @@ void Solver::initLevelToZonePos(void)
 {
 	int m = level->getRowsNumber();
 	int n = level->getColsNumber();
-	this->levelToZonePos = (int*)malloc(m*n*sizeof(int));
+	int* levelToZonePos = (int*)malloc(m*n*sizeof(int));
 
 	for(int i=0;i<m*n;i++)
-		this->levelToZonePos[i]=-1;
+		levelToZonePos[i]=-1;
 
 	for(int i=0;i<zoneToLevelPosLength;i++)
-		this->levelToZonePos[zoneToLevelPos[i]]=i;
+		levelToZonePos[zoneToLevelPos[i]]=i;
+
+	this->levelToZonePos = levelToZonePos;
 }
 
 void Solver::initGoalZone(void)
@@ -371,7 +468,7 @@ void Solver::initGoalZone(void)
 			zoneToLevelPosLength, Zone::PROCESS_GOAL);
 
 	int goalsNumber = level->getGoalsNumber();
-	goalsPositions = (int*)malloc(goalsNumber*sizeof(int));
+	int* goalsPositions = (int*)malloc(goalsNumber*sizeof(int));
 
 	int length = goalZone->getLength();
 	int k=0;
@@ -383,10 +480,70 @@ void Solver::initGoalZone(void)
 			k++;
 		}
 	}
+
+	this->goalsPositions = goalsPositions;
+}
+
+void Solver::initBoxToZonePos(void)
+{
+	deadSquareZone = new Zone(level, levelToZonePos, zoneToLevelPos,
+			zoneToLevelPosLength, Zone::PROCESS_DEADLOCK);
+
+	int* zoneToBoxPos = (int*)malloc(zoneToLevelPosLength*sizeof(int));
+	int* boxToZonePos = (int*)malloc(zoneToLevelPosLength*sizeof(int));
+	boxToZonePosLength = 0;
+	for(int i=0;i<zoneToLevelPosLength;i++)
+	{
+		if(deadSquareZone->readPos(i) == 1)
+			zoneToBoxPos[i] = -1;
+		else
+		{
+			zoneToBoxPos[i] = boxToZonePosLength;
+			boxToZonePos[boxToZonePosLength] = i;
+			boxToZonePosLength++;
+		}
+	}
+
+	this->zoneToBoxPos = zoneToBoxPos;
+	this->boxToZonePos = boxToZonePos;
+}
+
+void Solver::initPushes(void)
+{
+	// A box can be pushed in 4 directions
+	pushes = (Push*)malloc((4*level->getBoxesNumber()+1)*sizeof(Push));
+	pushBoxesZone = new Zone(zoneToLevelPosLength);
+}
+
+void Solver::initTunnels(void)
+{
+	int nCols = level->getColsNumber();
+	bool* tunnelTab = (bool*)malloc(2*zoneToLevelPosLength*sizeof(bool));
+
+	for(int i=0;i<zoneToLevelPosLength;i++)
+	{
+		int pos = zoneToLevelPos[i];
+
+		// Left or right move : walls up and down
+		tunnelTab[2*i] = (levelToZonePos[pos-nCols] == -1
+						  && levelToZonePos[pos+nCols] == -1);
+		// Up or down move : walls left and right
+		tunnelTab[2*i+1] = (levelToZonePos[pos-1] == -1
+						    && levelToZonePos[pos+1] == -1);
+	}
+
+	this->tunnelTab = tunnelTab;
+}
+
+void Solver::initGoalRoom(void)
+{
+	goalRoom = new GoalRoom(this);
 }
 
 void Solver::initDeadlockEngine(void)
 {
+	verdictCache = new VerdictCache(Deadlock::VERDICTCACHE_SIZE,
+			Deadlock::VERDICTCACHE_MAXITEMS);
 	deadlockEngine = new Deadlock(this);
 }
 
@@ -8,23 +8,33 @@
 
 #include "../../include/Solver/Stats.h"
 #include "../../include/Solver/BotBestPushesS/BotBestPushesS.h"
+#include "../../include/Solver/Deadlock.h"
 
 /* ------------*/
 /* Constructor */
 /* ------------*/
 Stats::Stats(Base* base, Solver* solver, TreeNode* treeNode, Path* solutionPath,
-		int numOfPushes, char* message):
+		int numOfPushes, const char* message):
 	base(base),
 	solver(solver),
 	treeNode(treeNode),
 	solved(solver->getSolved()),
 	solutionPath(solutionPath),
 	numOfPushes(numOfPushes),
-	message(NULL)
+	message(NULL),
+	checkCalls(NULL),
+	checkHits(NULL),
+	checkTimes(NULL),
+	checkEnabled(NULL)
 {
 	solved = solver->getSolved();
 	this->message = (char*)malloc((strlen(message)+1)*sizeof(char));
 	strcpy(this->message, message);
+
+	const Deadlock* engine = solver->getDeadlockEngine();
+	if(engine)
+		copyChecks(engine->getCheckCalls(), engine->getCheckHits(),
+				engine->getCheckTimes(), engine->getCheckEnabled());
 }
 
 Stats::Stats(const Stats* otherStats):
@@ -32,8 +42,15 @@ Stats::Stats(const Stats* otherStats):
 	solver(otherStats->getSolver()),
 	treeNode(otherStats->getTreeNode()),
 	solved(otherStats->getSolved()),
-	numOfPushes(otherStats->getNumOfPushes())
+	numOfPushes(otherStats->getNumOfPushes()),
+	checkCalls(NULL),
+	checkHits(NULL),
+	checkTimes(NULL),
+	checkEnabled(NULL)
 {
+	copyChecks(otherStats->getCheckCalls(), otherStats->getCheckHits(),
+			otherStats->getCheckTimes(), otherStats->getCheckEnabled());
+
 	char* otherMessage = otherStats->getMessage();
 	this->message = (char*)malloc((strlen(otherMessage)+1)*sizeof(char));
 	strcpy(this->message, otherMessage);
@@ -53,6 +70,14 @@ Stats::~Stats()
 		delete solutionPath;
 	if(message)
 		free(message);
+	if(checkCalls)
+		free(checkCalls);
+	if(checkHits)
+		free(checkHits);
+	if(checkTimes)
+		free(checkTimes);
+	if(checkEnabled)
+		free(checkEnabled);
 }
 
 /* -------*/
@@ -96,6 +121,26 @@ int* Stats::hashingRepartitionStats() const
 	return tab;
 }
 
+void Stats::copyChecks(const long long* calls, const long long* hits,
+		const long long* times, const bool* enabled)
+{
+	if(calls == NULL)
+		return;
+
+	int n = Deadlock::CHECK_NUMBER;
+	checkCalls = (long long*)malloc(n*sizeof(long long));
+	checkHits = (long long*)malloc(n*sizeof(long long));
+	checkTimes = (long long*)malloc(n*sizeof(long long));
+	checkEnabled = (bool*)malloc(n*sizeof(bool));
+	for(int i=0;i<n;i++)
+	{
+		checkCalls[i] = calls[i];
+		checkHits[i] = hits[i];
+		checkTimes[i] = times[i];
+		checkEnabled[i] = enabled[i];
+	}
+}
+
 void Stats::printInFile(const char* fileName) const
 {
 	FILE * file;
@@ -153,6 +198,15 @@ void Stats::printInFile(const char* fileName) const
 		fprintf(file, "Path : %s\n", this->solutionPath->getMoves());
 	}
 
+	if(checkCalls != NULL)
+	{
+		for(int i=0;i<Deadlock::CHECK_NUMBER;i++)
+			fprintf(file, "Deadlock check %s : %lld calls, %lld hits, "
+					"%lld ns%s\n", Deadlock::getCheckName(i), checkCalls[i],
+					checkHits[i], checkTimes[i],
+					checkEnabled[i] ? "" : " (disabled)");
+	}
+
 	fprintf(file, "\n--------------------------------------------------\n");
 
 	if(strcmp(solver->SOLVER_NAME(), "BotBestPushesS") == 0)
@@ -210,8 +210,8 @@ int TreeNode::getPusherPosition(void) const
 		//   4. We get last push of parent
 		int boxPosA = parentBoxPos;
 		int boxPosB = nodeBoxPos;
-		DijkstraBox* dBox = new DijkstraBox(node->getSolver(),
-				parent->getNode(), boxPosA);
+		DijkstraBox* dBox = node->getSolver()->getDijkstraBox();
+		dBox->setBox(parent->getNode(), boxPosA);
 		int* tmp = dBox->resolvePositions();
 
 		int min = INT_MAX;
@@ -226,7 +226,6 @@ int TreeNode::getPusherPosition(void) const
 			}
 		}
 		free(tmp);
-		delete dBox;
 
 		if(minDir == DijkstraBox::RIGHT)
 			pos = nodeBoxPos + 1;
@@ -384,13 +383,12 @@ Path* TreeNode::getPath(void)
 		// Find pusher moves to push box
 		int boxPosA = actualNode->getPushedBoxPrePosition();
 		int boxPosB = actualNode->getPushedBoxPostPosition();
-		DijkstraBox* dBox = new DijkstraBox(node->getSolver(),
-				parentNode->getNode(), boxPosA);
+		DijkstraBox* dBox = node->getSolver()->getDijkstraBox();
+		dBox->setBox(parentNode->getNode(), boxPosA);
 
 		int* tmp = dBox->resolvePositions();
 		free(tmp);
 		char* pusherMoves = dBox->listMovesToPosition(boxPosB);
-		delete dBox;
 
 		// Find pos of pusher before he pushes any box
 		int prePusherPos = -1;
@@ -0,0 +1,136 @@
+/*----------------------------------------------*/
+/*================== ISokoban ==================*/
+/*----------------------------------------------*/
+/* Version : 1.0								*/
+/* Author : Michaël Hoste						*/
+/* Copyright : See LICENSE file for details   	*/
+/*----------------------------------------------*/
+
+#include "../../include/Solver/VerdictCache.h"
+
+/* ------------*/
+/* Constructor */
+/* ------------*/
+VerdictCache::VerdictCache(int length, int maxItemNumber):
+	table(NULL),
+	length(length),
+	itemNumber(0),
+	maxItemNumber(maxItemNumber),
+	newest(NULL),
+	oldest(NULL),
+	hitNumber(0),
+	missNumber(0)
+{
+	table = (VerdictCacheItem**)malloc(length*sizeof(VerdictCacheItem*));
+	for(int i=0;i<length;i++)
+		table[i] = NULL;
+}
+
+/* -----------*/
+/* Destructor */
+/* -----------*/
+VerdictCache::~VerdictCache()
+{
+	VerdictCacheItem* item = newest;
+	while(item)
+	{
+		VerdictCacheItem* older = item->older;
+		delete item;
+		item = older;
+	}
+	free(table);
+}
+
+/* -------*/
+/* Others */
+/* -------*/
+int VerdictCache::getVerdict(const unsigned int* key, int keyLength)
+{
+	VerdictCacheItem* item = table[h(key, keyLength)];
+	while(item)
+	{
+		if(  item->keyLength == keyLength
+		  && memcmp(item->key, key, keyLength*sizeof(unsigned int)) == 0)
+		{
+			unlinkItem(item);
+			linkNewestItem(item);
+			hitNumber++;
+			return item->verdict;
+		}
+		item = item->next;
+	}
+
+	missNumber++;
+	return VERDICT_UNKNOWN;
+}
+
+void VerdictCache::addVerdict(const unsigned int* key, int keyLength,
+		int verdict)
+{
+	if(itemNumber >= maxItemNumber)
+		removeOldestItem();
+
+	int index = h(key, keyLength);
+	VerdictCacheItem* item = new VerdictCacheItem(key, keyLength, verdict);
+	item->next = table[index];
+	table[index] = item;
+	linkNewestItem(item);
+	itemNumber++;
+}
+
+int VerdictCache::h(const unsigned int* key, int keyLength) const
+{
+	unsigned int sum = 2166136261u;
+	for(int i=0;i<keyLength;i++)
+	{
+		sum ^= key[i];
+		sum *= 16777619u;
+	}
+
+	return sum%length;
+}
+
+void VerdictCache::unlinkItem(VerdictCacheItem* item)
+{
+	if(item->newer)
+		item->newer->older = item->older;
+	else
+		newest = item->older;
+
+	if(item->older)
+		item->older->newer = item->newer;
+	else
+		oldest = item->newer;
+
+	item->newer = NULL;
+	item->older = NULL;
+}
+
+void VerdictCache::linkNewestItem(VerdictCacheItem* item)
+{
+	item->older = newest;
+	item->newer = NULL;
+	if(newest)
+		newest->newer = item;
+	else
+		oldest = item;
+	newest = item;
+}
+
+void VerdictCache::removeOldestItem(void)
+{
+	VerdictCacheItem* item = oldest;
+	if(!item)
+		return;
+
+	unlinkItem(item);
+
+	// Remove item from its hash cell
+	VerdictCacheItem** cell = &table[h(item->key, item->keyLength)];
+	while(*cell != item)
+		cell = &((*cell)->next);
+	*cell = item->next;
+
+	delete item;
+	itemNumber--;
+}
@@ -13,19 +13,20 @@
 /* ------------*/
 Zone::Zone(const Zone* zone):
 	zone(NULL),
-	length(0)
+	length(0),
+	numberCell(0)
 {
 	copyZone(zone);
 }
 
 Zone::Zone(FILE* file, int numberOfPositions):
 	zone(NULL),
-	length(0)
+	length(0),
+	numberCell(0)
 {
 	this->length = numberOfPositions;
-	int intSize = sizeof(unsigned int);
+	allocateCells();
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 		fscanf(file, "%u ", &this->zone[i]);
@@ -34,12 +35,12 @@ Zone::Zone(FILE* file, int numberOfPositions):
 
 Zone::Zone(int numberOfPositions):
 	zone(NULL),
-	length(0)
+	length(0),
+	numberCell(0)
 {
 	this->length = numberOfPositions;
-	int intSize = sizeof(unsigned int);
+	allocateCells();
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 		this->zone[i] = 0;
@@ -47,8 +48,11 @@ Zone::Zone(int numberOfPositions):
 
 Zone::Zone(const Zone* zone1, const Zone* zone2, int operation):
 	zone(NULL),
-	length(zone1->getLength())
+	length(zone1->getLength()),
+	numberCell(0)
 {
+	allocateCells();
+
 	if(operation == USE_OR)
 		makeORZone(zone1, zone2);
 	else if(operation == USE_AND)
@@ -62,8 +66,11 @@ Zone::Zone(const Zone* zone1, const Zone* zone2, int operation):
 Zone::Zone(const Level* level, const int* levelToZonePos,
 		const int* zoneToLevelPos, int length, int operation):
 	zone(NULL),
-	length(length)
+	length(length),
+	numberCell(0)
 {
+	allocateCells();
+
 	if(operation == PROCESS_BOXES)
 		makeBoxesZone(level, zoneToLevelPos);
 	else if(operation == PROCESS_PUSHER)
@@ -77,11 +84,11 @@ Zone::Zone(const Level* level, const int* levelToZonePos,
 Zone::Zone(const Zone* boxes, const int startPos, const int* levelToZonePos,
 		int colsNumber):
 	zone(NULL),
-	length(boxes->getLength())
+	length(boxes->getLength()),
+	numberCell(0)
 {
-	int intSize = sizeof(unsigned int);
+	allocateCells();
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 		this->zone[i]=(unsigned int)0;
@@ -90,6 +97,55 @@ Zone::Zone(const Zone* boxes, const int startPos, const int* levelToZonePos,
 	recursiveMakePusherZone(boxes, startPos, levelToZonePos, colsNumber);
 }
 
+Zone::Zone(const Zone* parentPusher, const Zone* boxes, const int startPos,
+		const int boxPos, const int* levelToZonePos, int colsNumber):
+	zone(NULL),
+	length(0),
+	numberCell(0)
+{
+	copyZone(parentPusher);
+
+	int zoneStartPos = levelToZonePos[startPos];
+	int zoneBoxPos = levelToZonePos[boxPos];
+
+	// If pusher reached new box position, removing it from pusher moves may
+	// split the zone : make it again
+	bool boxInZone = (readPos(zoneBoxPos) == 1);
+	if(  boxInZone
+	  && !isLocallyConnected(boxes, boxPos, levelToZonePos, colsNumber))
+	{
+		for(int i=0;i<numberCell;i++)
+			this->zone[i]=(unsigned int)0;
+		recursiveMakePusherZone(boxes, startPos, levelToZonePos, colsNumber);
+		return;
+	}
+
+	// Old box position is free : add it and positions reached through it
+	write0ToPos(zoneStartPos);
+	recursiveMakePusherZone(boxes, startPos, levelToZonePos, colsNumber);
+
+	// New box position is next to the pusher. Boxes next to it may not be
+	// next to a place where pusher can move anymore
+	write1ToPos(zoneBoxPos);
+	if(boxInZone)
+	{
+		int direction = boxPos-startPos;
+		updatePusherBox(boxes, boxPos+direction, levelToZonePos, colsNumber);
+		if(direction == 1 || direction == -1)
+		{
+			updatePusherBox(boxes, boxPos+colsNumber, levelToZonePos,
+					colsNumber);
+			updatePusherBox(boxes, boxPos-colsNumber, levelToZonePos,
+					colsNumber);
+		}
+		else
+		{
+			updatePusherBox(boxes, boxPos+1, levelToZonePos, colsNumber);
+			updatePusherBox(boxes, boxPos-1, levelToZonePos, colsNumber);
+		}
+	}
+}
+
 /* -----------*/
 /* Destructor */
 /* -----------*/
@@ -233,27 +289,84 @@ bool Zone::isFullOf1() const
 
 bool Zone::isIncludedIn(const Zone* anotherZone) const
 {
-	// If node's boxes are all included in markedZone
-	Zone* junction = new Zone(this, anotherZone, Zone::USE_AND);
-	bool included = junction->isEgal(this);
-	delete junction;
+	const unsigned int* other = anotherZone->getZoneTab();
+	int nCells = getNumberCell();
+	for(int i=0;i<nCells;i++)
+	{
+		if((zone[i] & ~other[i]) != (unsigned int)0)
+			return false;
+	}
 
-	return included;
+	return true;
 }
 
 int Zone::getNumberOf1() const
 {
 	int total = 0;
-	for(int i=0;i<length;i++)
+	int nCells = getNumberCell();
+	for(int i=0;i<nCells-1;i++)
+		total += __builtin_popcount(zone[i]);
+	if(nCells > 0)
+		total += __builtin_popcount(zone[nCells-1] & lastCellMask());
+
+	return total;
+}
+
+bool Zone::intersects(const Zone* otherZone) const
+{
+	const unsigned int* other = otherZone->getZoneTab();
+	int nCells = getNumberCell();
+	for(int i=0;i<nCells;i++)
 	{
-		if(readPos(i) == 1)
-			total++;
+		if((zone[i] & other[i]) != (unsigned int)0)
+			return true;
 	}
 
+	return false;
+}
+
+bool Zone::andIsEmpty(const Zone* otherZone) const
+{
+	return !intersects(otherZone);
+}
+
+int Zone::andPopcount(const Zone* otherZone) const
+{
+	const unsigned int* other = otherZone->getZoneTab();
+	int total = 0;
+	int nCells = getNumberCell();
+	for(int i=0;i<nCells-1;i++)
+		total += __builtin_popcount(zone[i] & other[i]);
+	if(nCells > 0)
+		total += __builtin_popcount(zone[nCells-1] & other[nCells-1]
+				& lastCellMask());
+
 	return total;
 }
 
-Zone* Zone::applyOrWith(Zone* otherZone)
+bool Zone::isEgalIn(const Zone* otherZone, const Zone* maskZone) const
+{
+	const unsigned int* other = otherZone->getZoneTab();
+	const unsigned int* mask = maskZone->getZoneTab();
+	int nCells = getNumberCell();
+	for(int i=0;i<nCells;i++)
+	{
+		if(((zone[i] ^ other[i]) & mask[i]) != (unsigned int)0)
+			return false;
+	}
+
+	return true;
+}
+
+void Zone::andNotInto(const Zone* otherZone, Zone* destZone) const
+{
+	const unsigned int* other = otherZone->getZoneTab();
+	int nCells = getNumberCell();
+	for(int i=0;i<nCells;i++)
+		destZone->zone[i] = zone[i] & ~other[i];
+}
+
+Zone* Zone::applyOrWith(const Zone* otherZone)
 {
 	int nCells = getNumberCell();
 
@@ -263,7 +376,7 @@ Zone* Zone::applyOrWith(Zone* otherZone)
 	return this;
 }
 
-Zone* Zone::applyAndWith(Zone* otherZone)
+Zone* Zone::applyAndWith(const Zone* otherZone)
 {
 	int nCells = getNumberCell();
 
@@ -273,7 +386,7 @@ Zone* Zone::applyAndWith(Zone* otherZone)
 	return this;
 }
 
-Zone* Zone::applyXorWith(Zone* otherZone)
+Zone* Zone::applyXorWith(const Zone* otherZone)
 {
 	int nCells = getNumberCell();
 
@@ -293,13 +406,14 @@ Zone* Zone::applyNot()
 	return this;
 }
 
-Zone* Zone::applyMinusWith(Zone* otherZone)
+void Zone::clear(void)
 {
-	for(int i=0;i<length;i++)
-	{
-		if(otherZone->readPos(i) == 1)
-			write0ToPos(i);
-	}
+	memset(zone, 0, numberCell*sizeof(unsigned int));
+}
+
+Zone* Zone::applyMinusWith(const Zone* otherZone)
+{
+	andNotInto(otherZone, this);
 
 	return this;
 }
@@ -312,13 +426,24 @@ void Zone::saveInFile(FILE* file)
 	fprintf(file, "\n");
 }
 
+void Zone::saveInBinaryFile(FILE* file) const
+{
+	fwrite(this->zone, sizeof(unsigned int), getNumberCell(), file);
+}
+
+bool Zone::loadFromBinaryFile(FILE* file)
+{
+	int nCells = getNumberCell();
+	return ((int)fread(this->zone, sizeof(unsigned int), nCells, file)
+			== nCells);
+}
+
 void Zone::makeBoxesZone(const Level* level, const int* zoneToLevelPos)
 {
 	int intSize = sizeof(unsigned int);
 	int pos;
 	char cell;
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 		this->zone[i]=(unsigned int)0;
@@ -347,9 +472,7 @@ void Zone::makeBoxesZone(const Level* level, const int* zoneToLevelPos)
 void Zone::makePusherZone(const Level* level, const int* levelToZonePos,
 		const int* zoneToLevelPos)
 {
-	int intSize = sizeof(unsigned int);
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 		this->zone[i]=(unsigned int)0;
@@ -393,18 +516,88 @@ void Zone::recursiveMakePusherZone(const Zone* boxes, const int startPos,
 	}
 }
 
+bool Zone::isLocallyConnected(const Zone* boxes, const int pos,
+		const int* levelToZonePos, const int colsNumber) const
+{
+	int around[8];
+	getAroundPositions(pos, colsNumber, around);
+
+	bool freeTab[8];
+	for(int i=0;i<8;i++)
+	{
+		int zonePos = levelToZonePos[around[i]];
+		freeTab[i] = (zonePos != -1 && boxes->readPos(zonePos) == 0);
+	}
+
+	return isAroundConnected(freeTab);
+}
+
+void Zone::getAroundPositions(const int pos, const int colsNumber,
+		int* around)
+{
+	around[0] = pos-colsNumber-1;
+	around[1] = pos-colsNumber;
+	around[2] = pos-colsNumber+1;
+	around[3] = pos+1;
+	around[4] = pos+colsNumber+1;
+	around[5] = pos+colsNumber;
+	around[6] = pos+colsNumber-1;
+	around[7] = pos-1;
+}
+
+bool Zone::isAroundConnected(const bool* freeAround)
+{
+	// Count groups of following free positions with a neighbour of pos
+	// (odd indexes) in them
+	int groups = 0;
+	for(int i=1;i<8;i+=2)
+	{
+		if(!freeAround[i])
+			continue;
+
+		// Neighbour i starts a new group if it's not linked to the previous
+		// neighbour by free positions
+		if(!(freeAround[i-1] && freeAround[(i+6)%8]))
+			groups++;
+	}
+
+	// Every neighbour linked to the previous one : one circular group
+	if(groups == 0)
+		return true;
+
+	return groups == 1;
+}
+
+void Zone::updatePusherBox(const Zone* boxes, const int pos,
+		const int* levelToZonePos, const int colsNumber)
+{
+	int zonePos = levelToZonePos[pos];
+	if(zonePos == -1 || boxes->readPos(zonePos) == 0 || readPos(zonePos) == 0)
+		return;
+
+	int neighbours[4] = { pos-1, pos+1, pos-colsNumber, pos+colsNumber };
+	for(int i=0;i<4;i++)
+	{
+		int neighbour = levelToZonePos[neighbours[i]];
+		if(  neighbour != -1 && boxes->readPos(neighbour) == 0
+		  && readPos(neighbour) == 1)
+			return;
+	}
+
+	write0ToPos(zonePos);
+}
+
 void Zone::makeDeadlockZone(const Level* level, const int* levelToZonePos,
 		const int* zoneToLevelPos)
 {
-	int intSize = sizeof(unsigned int);
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 		this->zone[i]=(unsigned int)0;
 
 	makeCornerDeadlockZone(level, zoneToLevelPos);
 	makeLineDeadlockZone(level, levelToZonePos, zoneToLevelPos);
+	makePullDeadlockZone(level, levelToZonePos, zoneToLevelPos);
 }
 
 void Zone::makeCornerDeadlockZone(const Level* level,
@@ -467,7 +660,8 @@ void Zone::makeLineDeadlockZone(const Level* level,
 
 		// while cell is...
 		while(tempZonePos != -1 				 // ...not wall...
-		   && tempCar != '.' && tempCar != '*')  // ...and not goal
+		   && tempCar != '.' && tempCar != '*'
+		   && tempCar != '+')  // ...and not goal
 		{
 			// If the cell just above the actual cell is not wall
 			if(levelToZonePos[tempLevelPos-nCols] != -1)
@@ -508,7 +702,8 @@ void Zone::makeLineDeadlockZone(const Level* level,
 
 		// while cell is...
 		while(tempZonePos != -1 				 // ...not wall...
-		   && tempCar != '.' && tempCar != '*')  // ...and not goal
+		   && tempCar != '.' && tempCar != '*'
+		   && tempCar != '+')  // ...and not goal
 		{
 			// If the cell just above the actual cell is not wall
 			if(levelToZonePos[tempLevelPos-1] != -1)
@@ -543,13 +738,118 @@ void Zone::makeLineDeadlockZone(const Level* level,
 	free(cornerPos);
 }
 
+void Zone::makePullDeadlockZone(const Level* level,
+		const int* levelToZonePos, const int* zoneToLevelPos)
+{
+	int nCols = level->getColsNumber();
+	int dirTab[4] = {-1, 1, -nCols, nCols};
+
+	// reachedTab[4*pos+dir] : box on pos with pusher on side dir is reached
+	bool* reachedTab = (bool*)malloc(4*length*sizeof(bool));
+	bool* liveTab = (bool*)malloc(length*sizeof(bool));
+	bool* regionTab = (bool*)malloc(length*sizeof(bool));
+	int* queue = (int*)malloc(4*length*sizeof(int));
+	int* stack = (int*)malloc(length*sizeof(int));
+	for(int i=0;i<4*length;i++)
+		reachedTab[i] = false;
+	for(int i=0;i<length;i++)
+		liveTab[i] = false;
+
+	// Box on each goal with pusher on every free side
+	int queueStart = 0;
+	int queueEnd = 0;
+	for(int i=0;i<length;i++)
+	{
+		char car = level->readPos(zoneToLevelPos[i]);
+		if(car != '.' && car != '*' && car != '+')
+			continue;
+
+		liveTab[i] = true;
+		for(int d=0;d<4;d++)
+		{
+			if(levelToZonePos[zoneToLevelPos[i]+dirTab[d]] != -1)
+			{
+				reachedTab[4*i+d] = true;
+				queue[queueEnd] = 4*i+d;
+				queueEnd++;
+			}
+		}
+	}
+
+	// Pull box backwards
+	while(queueStart < queueEnd)
+	{
+		int boxPos = queue[queueStart]/4;
+		int side = queue[queueStart]%4;
+		int boxLevelPos = zoneToLevelPos[boxPos];
+		queueStart++;
+
+		// Region of pusher around the box
+		for(int i=0;i<length;i++)
+			regionTab[i] = false;
+		regionTab[boxPos] = true;
+		int stackLength = 1;
+		stack[0] = levelToZonePos[boxLevelPos+dirTab[side]];
+		regionTab[stack[0]] = true;
+		while(stackLength > 0)
+		{
+			stackLength--;
+			int pos = zoneToLevelPos[stack[stackLength]];
+			for(int d=0;d<4;d++)
+			{
+				int nextPos = levelToZonePos[pos+dirTab[d]];
+				if(nextPos != -1 && !regionTab[nextPos])
+				{
+					regionTab[nextPos] = true;
+					stack[stackLength] = nextPos;
+					stackLength++;
+				}
+			}
+		}
+
+		// Pull box from each side of the region
+		for(int d=0;d<4;d++)
+		{
+			int pusherPos = levelToZonePos[boxLevelPos+dirTab[d]];
+			if(pusherPos == -1 || !regionTab[pusherPos])
+				continue;
+
+			reachedTab[4*boxPos+d] = true;
+
+			// Pusher must be able to step back
+			if(levelToZonePos[boxLevelPos+2*dirTab[d]] == -1)
+				continue;
+
+			if(!reachedTab[4*pusherPos+d])
+			{
+				reachedTab[4*pusherPos+d] = true;
+				liveTab[pusherPos] = true;
+				queue[queueEnd] = 4*pusherPos+d;
+				queueEnd++;
+			}
+		}
+	}
+
+	// Position never reached by a box is a deadlock
+	for(int i=0;i<length;i++)
+	{
+		if(!liveTab[i])
+			write1ToPos(i);
+	}
+
+	free(reachedTab);
+	free(liveTab);
+	free(regionTab);
+	free(queue);
+	free(stack);
+}
+
 void Zone::makeGoalZone(const Level* level, const int* zoneToLevelPos)
 {
 	int intSize = sizeof(unsigned int);
 	int pos;
 	char cell;
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 		this->zone[i]=(unsigned int)0;
@@ -576,9 +876,7 @@ void Zone::makeGoalZone(const Level* level, const int* zoneToLevelPos)
 
 void Zone::makeORZone(const Zone* zone1, const Zone* zone2)
 {
-	int intSize = sizeof(unsigned int);
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 	{
@@ -588,9 +886,7 @@ void Zone::makeORZone(const Zone* zone1, const Zone* zone2)
 
 void Zone::makeANDZone(const Zone* zone1, const Zone* zone2)
 {
-	int intSize = sizeof(unsigned int);
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 	{
@@ -600,9 +896,7 @@ void Zone::makeANDZone(const Zone* zone1, const Zone* zone2)
 
 void Zone::makeXORZone(const Zone* zone1, const Zone* zone2)
 {
-	int intSize = sizeof(unsigned int);
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 	{
@@ -612,9 +906,7 @@ void Zone::makeXORZone(const Zone* zone1, const Zone* zone2)
 
 void Zone::makeNOTZone(const Zone* zone1)
 {
-	int intSize = sizeof(unsigned int);
 	int nCells = getNumberCell();
-	this->zone = (unsigned int*)malloc(nCells*intSize);
 
 	for(int i=0;i<nCells;i++)
 	{
@@ -622,13 +914,33 @@ void Zone::makeNOTZone(const Zone* zone1)
 	}
 }
 
+void Zone::allocateCells(void)
+{
+	int cellSize = 8*sizeof(unsigned int);
+	numberCell = (length+cellSize-1)/cellSize;
+
+	this->zone = (unsigned int*)malloc(numberCell*sizeof(unsigned int));
+}
+
+unsigned int Zone::lastCellMask(void) const
+{
+	int cellSize = 8*sizeof(unsigned int);
+	int usedBits = length - (numberCell-1)*cellSize;
+
+	// First positions are the most significant bits of a cell
+	if(usedBits >= cellSize)
+		return ~(unsigned int)0;
+	else
+		return ~(unsigned int)0 << (cellSize-usedBits);
+}
+
 void Zone::copyZone(const Zone* source)
 {
 	this->length = source->getLength();
 	if(length > 0)
 	{
+		allocateCells();
 		int nCells = getNumberCell();
-		this->zone = (unsigned int*)malloc(nCells*sizeof(unsigned int));
 
 		for(int i=0;i<nCells;i++)
 		{
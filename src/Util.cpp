@@ -205,3 +205,14 @@ bool Util::isThisRepExists(char* rep)
 	}
 }
 
+long long Util::getNanoTime(void)
+{
+#ifdef SLINUX
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (long long)t.tv_sec*1000000000LL + t.tv_nsec;
+#else
+	// Processor time (SWIN32 and others)
+	return (long long)clock()*(1000000000LL/CLOCKS_PER_SEC);
+#endif
+}